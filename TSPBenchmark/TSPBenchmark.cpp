@@ -0,0 +1,366 @@
+#include "Ant.h"
+#include "KOptSolver.h"
+#include "Pheromone.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <sstream>
+using namespace chrono;
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define TSP_HAS_RDTSC
+#endif
+
+/// <summary>
+/// Счетчик тактов (TSC идет с номинальной частотой процессора).
+/// Без TSC - наносекунды steady_clock
+/// </summary>
+unsigned long long cycles()
+{
+#ifdef TSP_HAS_RDTSC
+	return __rdtsc();
+#else
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/// <summary>
+/// Результат замера ядра:
+/// <para> - kernel (название ядра) </para>
+/// <para> - n (размер задачи) </para>
+/// <para> - cycles (тактов на элемент, медиана по повторам) </para>
+/// <para> - ns (наносекунд на элемент) </para>
+/// <para> - bytes (байт памяти на элемент по модели ядра) </para>
+/// </summary>
+struct Result
+{
+	string kernel;
+	int n;
+	double cycles, ns, bytes;
+};
+
+/// <summary>
+/// Замер ядра: prepare готовит данные (не замеряется), run выполняет
+/// ядро, обрабатывая elements элементов. Ядро повторяется inner раз
+/// подряд, чтобы один замер длился не меньше ~10^7 элементов
+/// </summary>
+/// <param name="kernel"> название ядра </param>
+/// <param name="n"> размер задачи </param>
+/// <param name="elements"> число элементов за один запуск ядра </param>
+/// <param name="bytes"> байт памяти на элемент по модели ядра </param>
+/// <param name="reps"> число замеров </param>
+/// <param name="prepare"> подготовка данных перед каждым запуском </param>
+/// <param name="run"> ядро </param>
+Result measure(const string& kernel, int n, double elements, double bytes, int reps,
+	function<void()> prepare, function<void()> run)
+{
+	int inner = max(1, (int)(1e7 / elements));
+
+	vector<double> c(reps), t(reps);
+
+	// прогрев: страницы, кэши, частота процессора
+	prepare();
+	run();
+
+	for (int r = 0; r < reps; ++r)
+	{
+		unsigned long long total = 0;
+		double seconds = 0;
+
+		for (int k = 0; k < inner; ++k)
+		{
+			prepare();
+
+			steady_clock::time_point start = steady_clock::now();
+			unsigned long long c0 = cycles();
+
+			run();
+
+			unsigned long long c1 = cycles();
+			steady_clock::time_point end = steady_clock::now();
+
+			total += c1 - c0;
+			seconds += duration<double>(end - start).count();
+		}
+
+		c[r] = total / (elements * inner);
+		t[r] = 1e9 * seconds / (elements * inner);
+	}
+
+	nth_element(c.begin(), c.begin() + reps / 2, c.end());
+	nth_element(t.begin(), t.begin() + reps / 2, t.end());
+
+	return { kernel, n, c[reps / 2], t[reps / 2], bytes };
+}
+
+/// <summary>
+/// Синтетический граф: дуги i -> i + 1 имеют длину 1, остальные -
+/// случайную длину из [2, 1000]. Тур 0 -> 1 -> ... -> n - 1 -> 0
+/// оптимален, поэтому k-opt не находит улучшающих ходов и выполняет
+/// ровно один полный просмотр кандидатов
+/// </summary>
+/// <param name="n"> число вершин </param>
+Graph synthetic_graph(int n)
+{
+	mt19937 rnd(n);
+	uniform_int_distribution<int> len(2, 1000);
+
+	vector<int> data((size_t)n * n);
+
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < n; ++j)
+			data[(size_t)i * n + j] = i == j ? 0 : (j == (i + 1) % n ? 1 : len(rnd));
+
+	return Graph(move(data), n);
+}
+
+/// <summary>
+/// Случайная матрица из (0, 1] в арене
+/// </summary>
+Matrix<double> random_matrix(Arena& arena, int n, mt19937& rnd)
+{
+	uniform_real_distribution<double> value(1e-3, 1);
+
+	Matrix<double> m = arena.matrix<double>(n, n);
+
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < n; ++j)
+			m[i][j] = value(rnd);
+
+	return m;
+}
+
+/// <summary>
+/// Замеряем все ядра на графе из n вершин
+/// </summary>
+/// <param name="n"> число вершин </param>
+/// <param name="n_jobs"> число потоков для ядер феромонов </param>
+/// <param name="filter"> замеряются только ядра с этим названием (пусто - все) </param>
+/// <param name="results"> результаты </param>
+void bench_size(int n, int n_jobs, const string& filter, vector<Result>& results)
+{
+	auto wanted = [&](const string& kernel) { return filter.empty() || filter == kernel; };
+
+	int reps = n <= 1000 ? 7 : 3;
+
+	Graph g = synthetic_graph(n);
+
+	mt19937 rnd(n);
+
+	Arena arena;
+	arena.reserve(3 * Matrix<double>::bytes(n, n) + 2 * Matrix<int>::bytes(1, n));
+
+	Matrix<double> tau = random_matrix(arena, n, rnd);
+	Matrix<double> eta_beta = random_matrix(arena, n, rnd);
+	Matrix<double> weights = random_matrix(arena, n, rnd);
+
+	Matrix<int> visited = arena.matrix<int>(1, n);
+	Matrix<int> choices = arena.matrix<int>(1, n);
+
+	vector<int> identity(n + 1);
+
+	for (int i = 0; i <= n; ++i)
+		identity[i] = i % n;
+
+	vector<int> tour = identity;
+	shuffle(tour.begin() + 1, tour.end() - 1, rnd);
+
+	// Ant::next: n - 1 выборов, каждый просматривает строку из n элементов
+	// (visited 4 + weights 8 + choices 4 байт)
+	if (wanted("next"))
+	{
+		Ant ant;
+
+		results.push_back(measure("next", n, (double)n * (n - 1), 16, reps,
+			[&]() { fill(visited[0], visited[0] + n, 0); },
+			[&]() { ant.solve(g, 0, visited[0], choices[0], weights); }));
+	}
+
+	// weights = tau^alpha * eta_beta (чтение 8 + 8, запись 8 байт)
+	if (wanted("weights"))
+		results.push_back(measure("weights", n, (double)n * n, 24, reps, []() {},
+			[&]() { update_weights(weights, tau, eta_beta, 1.5, n_jobs); }));
+
+	// испарение (чтение и запись tau)
+	if (wanted("evaporate"))
+		results.push_back(measure("evaporate", n, (double)n * n, 16, reps, []() {},
+			[&]() { evaporate(tau, 0.02, n_jobs); }));
+
+	// след одного тура: произвольный доступ к tau (чтение и запись 8 байт)
+	if (wanted("deposit"))
+		results.push_back(measure("deposit", n, n, 16, reps, []() {},
+			[&]() { deposit_tour(tau, tour, 1e-3, n_jobs); }));
+
+	// то же для MMAS: испарение с нижней границей, испарение с подсчетом
+	// коэффициента ветвления (второй проход по строке) и след с верхней границей
+	if (wanted("mmas-evap"))
+		results.push_back(measure("mmas-evap", n, (double)n * n, 16, reps, []() {},
+			[&]() { evaporate_clamped(tau, 0.02, 1e-6, n_jobs); }));
+
+	if (wanted("mmas-bf"))
+		results.push_back(measure("mmas-bf", n, (double)n * n, 24, reps, []() {},
+			[&]() { evaporate_branching(tau, 0.02, 1e-6, 0.05, n_jobs); }));
+
+	if (wanted("mmas-dep"))
+		results.push_back(measure("mmas-dep", n, n, 16, reps, []() {},
+			[&]() { deposit_tour_clamped(tau, tour, 1e-3, 1.0, n_jobs); }));
+
+	// один полный просмотр ходов k-opt на оптимальном туре
+	KOptSolver ls;
+
+	// (n - 1)(n - 2) / 2 ходов: 2 дуги из g, 2 вершины тура, 2 префикса
+	if (wanted("2-opt"))
+		results.push_back(measure("2-opt", n, (n - 1.0) * (n - 2) / 2, 24, reps, []() {},
+			[&]() { ls.solve(g, LocalSearchType::TwoOpt, identity, n); }));
+
+	// (n - 3) + (n - 1)(n - 3) ходов: 3 дуги из g, 3 длины дуг тура, 4 вершины тура
+	if (wanted("2.5-opt"))
+		results.push_back(measure("2.5-opt", n, (n - 3.0) * n, 40, reps, []() {},
+			[&]() { ls.solve(g, LocalSearchType::TwoHalfOpt, identity, n); }));
+
+	// C(n, 3) ходов: 3 дуги из g, 3 длины дуг тура, 4 вершины тура.
+	// Просмотр кубический, поэтому только до 1000 вершин
+	if (wanted("3-opt") && n <= 1000)
+		results.push_back(measure("3-opt", n, n * (n - 1.0) * (n - 2) / 6, 40, n <= 300 ? reps : 1, []() {},
+			[&]() { ls.solve(g, LocalSearchType::ThreeOpt, identity, n); }));
+}
+
+/// <summary>
+/// Считываем сохраненные результаты (CSV: kernel,n,cycles,ns,bytes)
+/// </summary>
+/// <param name="path"> путь к файлу </param>
+/// <returns> такты на элемент по паре (ядро, размер) </returns>
+map<pair<string, int>, double> load_baseline(const string& path)
+{
+	ifstream fin(path);
+
+	if (!fin.is_open()) throw runtime_error("cannot open baseline: " + path);
+
+	map<pair<string, int>, double> baseline;
+	string line;
+
+	// заголовок
+	getline(fin, line);
+
+	while (getline(fin, line))
+	{
+		stringstream row(line);
+		string kernel, n, c;
+
+		if (getline(row, kernel, ',') && getline(row, n, ',') && getline(row, c, ','))
+			baseline[{ kernel, stoi(n) }] = stod(c);
+	}
+
+	return baseline;
+}
+
+/// <summary>
+/// Сохраняем результаты (CSV: kernel,n,cycles,ns,bytes)
+/// </summary>
+void save_results(const string& path, vector<Result>& results)
+{
+	ofstream out(path);
+
+	if (!out.is_open()) throw runtime_error("cannot write results: " + path);
+
+	out << "kernel,n,cycles,ns,bytes\n";
+
+	for (Result& r : results)
+		out << r.kernel << "," << r.n << "," << r.cycles << "," << r.ns << "," << r.bytes << "\n";
+}
+
+/// <summary>
+/// Микробенчмарк ядер: выбор следующего города муравьем, пересчет
+/// значимостей, испарение и откладывание феромонов, просмотр ходов
+/// 2-opt / 2.5-opt / 3-opt на синтетических графах.
+/// <para> Параметры: </para>
+/// <para> --sizes 100,1000   размеры графов (по умолчанию 100, 300, 1000, 3000, 10000) </para>
+/// <para> --kernel name      только одно ядро (next, weights, evaporate, deposit, mmas-evap, mmas-bf, mmas-dep, 2-opt, 2.5-opt, 3-opt) </para>
+/// <para> --jobs N           число потоков для ядер феромонов (по умолчанию 1) </para>
+/// <para> --baseline file    сравнить с сохраненными результатами </para>
+/// <para> --save file        сохранить результаты </para>
+/// </summary>
+int main(int argc, char** argv)
+{
+	setlocale(LC_ALL, "Russian");
+
+	vector<int> sizes = { 100, 300, 1000, 3000, 10000 };
+	string filter, baseline_path, save_path;
+	int n_jobs = 1;
+
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		string key = argv[i], value = argv[i + 1];
+
+		if (key == "--sizes")
+		{
+			sizes.clear();
+
+			stringstream list(value);
+			string size;
+
+			while (getline(list, size, ','))
+				sizes.push_back(stoi(size));
+		}
+		else if (key == "--kernel") filter = value;
+		else if (key == "--jobs") n_jobs = stoi(value);
+		else if (key == "--baseline") baseline_path = value;
+		else if (key == "--save") save_path = value;
+		else
+		{
+			cerr << "unknown option: " << key << "\n";
+			return 1;
+		}
+	}
+
+	map<pair<string, int>, double> baseline;
+
+	if (!baseline_path.empty()) baseline = load_baseline(baseline_path);
+
+	vector<Result> results;
+
+	for (int n : sizes)
+		bench_size(n, n_jobs, filter, results);
+
+#ifdef TSP_HAS_RDTSC
+	string unit = "Такты/эл.";
+#else
+	string unit = "  нс/эл. ";
+#endif
+
+	cout << fixed << setprecision(2);
+
+	cout << "+-----------+-------+------------+-----------+----------+-----------+\n";
+	cout << "|   Ядро    |   n   | " << unit << "  |  нс/эл.   | Байт/эл. | Ускорение |\n";
+	cout << "+-----------+-------+------------+-----------+----------+-----------+\n";
+
+	for (Result& r : results)
+	{
+		cout << left << "| " << setw(9) << r.kernel << " | " << setw(5) << r.n << " |  " << setw(8) << r.cycles
+			<< "  |  " << setw(7) << r.ns << "  |  " << setw(6) << r.bytes << "  |  ";
+
+		// ускорение относительно сохраненных результатов (> 1 - быстрее)
+		auto it = baseline.find({ r.kernel, r.n });
+
+		ostringstream speedup;
+
+		if (it != baseline.end()) speedup << fixed << setprecision(2) << it->second / r.cycles << "x";
+		else speedup << "----";
+
+		cout << setw(7) << speedup.str();
+
+		cout << "  |\n";
+	}
+
+	cout << "+-----------+-------+------------+-----------+----------+-----------+\n";
+
+	if (!save_path.empty()) save_results(save_path, results);
+
+	return 0;
+}
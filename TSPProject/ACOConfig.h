@@ -0,0 +1,371 @@
+#pragma once
+#include <string>
+#include <map>
+#include <any>
+#include <stdexcept>
+
+#include "KOptSolver.h"
+#include "Affinity.h"
+#include "Reorder.h"
+
+/// <summary>
+///   :
+/// <para> - AS (Ant System) </para>
+/// <para> - EAS (Elitist Ant System) </para>
+/// <para> - ASRank (Rank-based Ant System) </para>
+/// <para> - MMAS (Max-Min Ant System) </para>
+/// <para> - PACO (Population-based ACO) </para>
+/// <para> - ACS (Ant Colony System) </para>
+/// </summary>
+enum class ACOType { AS, EAS, ASRank, MMAS, PACO, ACS };
+
+/// <summary>
+///     :
+/// <para> - KBest (k  ) </para>
+/// <para> - KRandom (k  ) </para>
+/// </summary>
+enum class LocalSearchTours { KBest, KRandom };
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="name"> : AS, EAS, ASRank, MMAS, PACO, ACS </param>
+/// <returns>    </returns>
+ACOType to_aco_type(const string& name)
+{
+	if (name == "AS") return ACOType::AS;
+	if (name == "EAS") return ACOType::EAS;
+	if (name == "ASRank") return ACOType::ASRank;
+	if (name == "MMAS") return ACOType::MMAS;
+	if (name == "PACO") return ACOType::PACO;
+	if (name == "ACS") return ACOType::ACS;
+
+	throw invalid_argument("unknown ACO type: " + name);
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="type">    </param>
+/// <returns> : AS, EAS, ASRank, MMAS, PACO, ACS </returns>
+string to_string(ACOType type)
+{
+	switch (type)
+	{
+	case ACOType::EAS: return "EAS";
+	case ACOType::ASRank: return "ASRank";
+	case ACOType::MMAS: return "MMAS";
+	case ACOType::PACO: return "PACO";
+	case ACOType::ACS: return "ACS";
+	default: return "AS";
+	}
+}
+
+/// <summary>
+///   
+/// </summary>
+struct ACOConfig
+{
+	/// <summary>
+	///  
+	/// </summary>
+	ACOType type = ACOType::MMAS;
+
+	/// <summary>
+	///  :
+	/// <para> - alpha ( ) </para>
+	/// <para> - beta (  ) </para>
+	/// <para> - rho (  ) </para>
+	/// <para> - tau0 ( -   ) </para>
+	/// </summary>
+	double alpha = 1, beta = 2, rho = 0.2, tau0 = 0;
+
+	/// <summary>
+	///  :
+	/// <para> - n_ants ( ) </para>
+	/// <para> - max_iter ( ) </para>
+	/// <para> - n_jobs (  ) </para>
+	/// </summary>
+	int n_ants = 24, max_iter = 1000, n_jobs = 1;
+
+	/// <summary>
+	///       ( 
+	/// ,  ),       
+	/// split_min_cities :      
+	///     
+	/// </summary>
+	int split_min_cities = 2048;
+
+	/// <summary>
+	///  w:
+	/// <para> - EAS (  ) </para>
+	/// <para> - ASRank (  , 
+	///     ) </para>
+	/// <para> - PACO (     ,   
+	///  ,  tau0) </para>
+	/// </summary>
+	int w = 0;
+
+	/// <summary>
+	///    (PACO):
+	/// <para> - pop_size (   ) </para>
+	/// </summary>
+	int pop_size = 0;
+
+	/// <summary>
+	///    (ACS):
+	/// <para> - q0 (    ) </para>
+	/// <para> - xi (   ) </para>
+	/// </summary>
+	double q0 = 0.9, xi = 0.1;
+
+	/// <summary>
+	///    (MMAS):
+	/// <para> - a ( tau_min / tau_max) </para>
+	/// <para> - lambda (    lambda- ) </para>
+	/// <para> - restart_bf (   ,  
+	///    tau_max; 0 -  ) </para>
+	/// </summary>
+	double a = 0, lambda = 0.05, restart_bf = 0;
+
+	/// <summary>
+	///    (MMAS):
+	/// <para> - restart_wait (   ,  
+	///  ) </para>
+	/// </summary>
+	int restart_wait = 50;
+
+	/// <summary>
+	///   ,   (MMAS)
+	/// </summary>
+	LocalSearchType local_search_type = LocalSearchType::None;
+
+	/// <summary>
+	///     
+	/// </summary>
+	LocalSearchTours local_search_tours = LocalSearchTours::KRandom;
+
+	/// <summary>
+	///  k:
+	///  ,    
+	/// 
+	/// </summary>
+	int k = 0;
+
+	/// <summary>
+	///  :
+	/// <para> - lower_bound (   , . LowerBound.h;
+	/// 0 - ) </para>
+	/// <para> - target_gap ( ,  
+	/// (len - lower_bound) / lower_bound   target_gap) </para>
+	/// </summary>
+	int lower_bound = 0;
+	double target_gap = 0;
+
+	/// <summary>
+	///   (     ):
+	/// <para> - checkpoint_path ( ) </para>
+	/// <para> - checkpoint_interval (   checkpoint_interval
+	/// ; 0 -  ) </para>
+	/// </summary>
+	string checkpoint_path;
+	int checkpoint_interval = 0;
+
+	/// <summary>
+	///  :
+	/// <para> - warm_bias (       
+	///  tau0) </para>
+	/// </summary>
+	double warm_bias = 5;
+
+	/// <summary>
+	///     (     NUMA;
+	///  n_jobs = 1   )
+	/// </summary>
+	AffinityPolicy affinity = AffinityPolicy::None;
+
+	/// <summary>
+	///     :  
+	///    ,     .
+	///       
+	///  ( n^2 );       
+	/// </summary>
+	ReorderType reorder = ReorderType::None;
+
+	/// <summary>
+	///   
+	/// </summary>
+	/// <exception cref="invalid_argument">    </exception>
+	void validate() const
+	{
+		auto check = [](bool ok, const string& what)
+		{
+			if (!ok) throw invalid_argument("invalid ACO parameter: " + what);
+		};
+
+		check(alpha >= 0, "alpha >= 0");
+		check(beta >= 0, "beta >= 0");
+		check(rho > 0 && rho <= 1, "0 < rho <= 1");
+		check(tau0 > 0, "tau0 > 0");
+		check(n_ants > 0, "n_ants > 0");
+		check(max_iter >= 0, "max_iter >= 0");
+		check(n_jobs > 0, "n_jobs > 0");
+		check(split_min_cities > 0, "split_min_cities > 0");
+		check(lower_bound >= 0, "lower_bound >= 0");
+		check(target_gap >= 0, "target_gap >= 0");
+		check(checkpoint_interval >= 0, "checkpoint_interval >= 0");
+		check(warm_bias >= 1, "warm_bias >= 1");
+
+		if (checkpoint_interval > 0) check(!checkpoint_path.empty(), "checkpoint_path is set");
+
+		if (type == ACOType::EAS) check(w > 0, "w > 0");
+		if (type == ACOType::ASRank) check(w > 0 && w <= n_ants + 1, "0 < w <= n_ants + 1");
+
+		if (type == ACOType::PACO)
+		{
+			check(w > 0, "w > 0");
+			check(pop_size > 0, "pop_size > 0");
+		}
+
+		if (type == ACOType::ACS)
+		{
+			check(q0 >= 0 && q0 <= 1, "0 <= q0 <= 1");
+			check(xi > 0 && xi <= 1, "0 < xi <= 1");
+		}
+
+		if (type == ACOType::MMAS)
+		{
+			check(a > 0 && a < 1, "0 < a < 1");
+			check(restart_bf >= 0, "restart_bf >= 0");
+			check(lambda > 0 && lambda < 1, "0 < lambda < 1");
+			check(restart_wait >= 0, "restart_wait >= 0");
+
+			if (local_search_type != LocalSearchType::None)
+				check(k > 0 && k <= n_ants, "0 < k <= n_ants");
+		}
+	}
+
+	/// <summary>
+	///    (   ):
+	///      int,   double
+	/// </summary>
+	/// <param name="type">   </param>
+	/// <param name="params">    </param>
+	/// <returns>   </returns>
+	static ACOConfig from_map(const string& type, const map<string, any>& params)
+	{
+		ACOConfig config;
+		config.type = to_aco_type(type);
+
+		auto has = [&](const string& key) { return params.count(key) > 0; };
+
+		auto get = [&](const string& key) -> const any&
+		{
+			auto it = params.find(key);
+			if (it == params.end()) throw invalid_argument("missing ACO parameter: " + key);
+
+			return it->second;
+		};
+
+		auto get_double = [&](const string& key)
+		{
+			const any& value = get(key);
+
+			if (value.type() == typeid(int)) return (double)any_cast<int>(value);
+			if (value.type() == typeid(double)) return any_cast<double>(value);
+
+			throw invalid_argument("ACO parameter must be a number: " + key);
+		};
+
+		auto get_int = [&](const string& key)
+		{
+			const any& value = get(key);
+
+			if (value.type() == typeid(int)) return any_cast<int>(value);
+			if (value.type() == typeid(double) && any_cast<double>(value) == (int)any_cast<double>(value))
+				return (int)any_cast<double>(value);
+
+			throw invalid_argument("ACO parameter must be an integer: " + key);
+		};
+
+		auto get_string = [&](const string& key)
+		{
+			const any& value = get(key);
+
+			if (value.type() == typeid(string)) return any_cast<string>(value);
+			if (value.type() == typeid(const char*)) return string(any_cast<const char*>(value));
+
+			throw invalid_argument("ACO parameter must be a string: " + key);
+		};
+
+		//  
+		config.alpha = get_double("alpha");
+		config.beta = get_double("beta");
+		config.rho = get_double("rho");
+		config.tau0 = get_double("tau0");
+
+		//  
+		config.n_ants = get_int("n_ants");
+		config.max_iter = get_int("max_iter");
+		config.n_jobs = get_int("n_jobs");
+
+		if (has("split_min_cities")) config.split_min_cities = get_int("split_min_cities");
+
+		//  
+		if (has("lower_bound")) config.lower_bound = get_int("lower_bound");
+		if (has("target_gap")) config.target_gap = get_double("target_gap");
+
+		//  
+		if (has("checkpoint_path")) config.checkpoint_path = get_string("checkpoint_path");
+		if (has("checkpoint_interval")) config.checkpoint_interval = get_int("checkpoint_interval");
+
+		//  
+		if (has("warm_bias")) config.warm_bias = get_double("warm_bias");
+
+		//  
+		if (has("affinity")) config.affinity = to_affinity_policy(get_string("affinity"));
+
+		//  
+		if (has("reorder")) config.reorder = to_reorder_type(get_string("reorder"));
+
+		//       
+		if (config.type == ACOType::EAS || config.type == ACOType::ASRank || config.type == ACOType::PACO)
+			config.w = get_int("w");
+
+		if (config.type == ACOType::PACO) config.pop_size = get_int("pop_size");
+
+		//     
+		if (config.type == ACOType::ACS)
+		{
+			config.q0 = get_double("q0");
+			config.xi = get_double("xi");
+		}
+
+		//     
+		if (config.type == ACOType::MMAS)
+		{
+			config.a = get_double("a");
+
+			if (has("restart_bf")) config.restart_bf = get_double("restart_bf");
+			if (has("lambda")) config.lambda = get_double("lambda");
+			if (has("restart_wait")) config.restart_wait = get_int("restart_wait");
+
+			config.local_search_type = to_local_search_type(get_string("local_search_type"));
+
+			//       
+			if (config.local_search_type != LocalSearchType::None)
+			{
+				string tours = get_string("local_search_tours");
+
+				if (tours == "k-best") config.local_search_tours = LocalSearchTours::KBest;
+				else if (tours == "k-random") config.local_search_tours = LocalSearchTours::KRandom;
+				else throw invalid_argument("unknown local search tours: " + tours);
+
+				config.k = get_int("k");
+			}
+		}
+
+		config.validate();
+		return config;
+	}
+};
@@ -2,15 +2,27 @@
 #include <string>
 #include <map>
 #include <any>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <future>
+#include <cstdio>
 
 #include <chrono>
 using namespace chrono;
 
-#include "KOptSolver.h"
+#include "ACOConfig.h"
 #include "Ant.h"
+#include "Pheromone.h"
+#include "Async.h"
 
 ofstream fout("iter_time.txt");
 
+/// <summary>
+///  fout     
+/// </summary>
+mutex fout_mutex;
+
 /// <summary>
 ///    
 ///  
@@ -23,8 +35,10 @@ class ACOSolver : public TSPSolver
 	/// <para> - EAS (Elitist Ant System) </para>
 	/// <para> - ASRank (Rank-based Ant System) </para>
 	/// <para> - MMAS (Max-Min Ant System) </para>
+	/// <para> - PACO (Population-based ACO) </para>
+	/// <para> - ACS (Ant Colony System) </para>
 	/// </summary>
-	string _type;
+	ACOType _type;
 
 	/// <summary>
 	///  :
@@ -43,14 +57,41 @@ class ACOSolver : public TSPSolver
 	/// </summary>
 	int _n_ants, _max_iter, _n_jobs;
 
+	/// <summary>
+	///        
+	///    
+	/// </summary>
+	int _split_min_cities;
+
 	/// <summary>
 	///  w:
 	/// <para> - EAS (  ) </para>
 	/// <para> - ASRank (  , 
 	///     ) </para>
+	/// <para> - PACO (     ,   
+	///  ,  tau0) </para>
 	/// </summary>
 	int _w;
 
+	/// <summary>
+	///    (PACO):
+	/// <para> - pop_size (   ) </para>
+	/// </summary>
+	int _pop_size;
+
+	/// <summary>
+	///      (PACO), 
+	/// :     
+	/// </summary>
+	deque<vector<int>> _population;
+
+	/// <summary>
+	///    (ACS):
+	/// <para> - q0 (    ) </para>
+	/// <para> - xi (   ) </para>
+	/// </summary>
+	double _q0, _xi;
+
 	/// <summary>
 	///    (MMAS):
 	/// <para> - tau_min (    ) </para>
@@ -59,21 +100,38 @@ class ACOSolver : public TSPSolver
 	/// </summary>
 	double _tau_min, _tau_max, _a;
 
+	/// <summary>
+	///     (MMAS):
+	/// <para> - lambda (    lambda- ) </para>
+	/// <para> - restart_bf (   ,  
+	///    tau_max; 0 -  ) </para>
+	/// </summary>
+	double _lambda, _restart_bf;
+
+	/// <summary>
+	///     (MMAS):
+	/// <para> - restart_wait (   ,  
+	///  ) </para>
+	/// </summary>
+	int _restart_wait;
+
 	/// <summary>
 	///   ,  :
 	/// <para> - None (  ) </para>
 	/// <para> - 2-opt </para>
 	/// <para> - 2.5-opt </para>
 	/// <para> - 3-opt </para>
+	/// <para> - Or-opt ( ,  ) </para>
+	/// <para> - Or-3opt (3-opt  ) </para>
 	/// </summary>
-	string _local_search_type;
+	LocalSearchType _local_search_type;
 
 	/// <summary>
 	///   ,  :
 	/// <para> - k-best (k  ) </para>
 	/// <para> - k-random (k  ) </para>
 	/// </summary>
-	string _local_search_tours;
+	LocalSearchTours _local_search_tours;
 
 	/// <summary>
 	///  k:
@@ -90,7 +148,7 @@ class ACOSolver : public TSPSolver
 	/// <para> - weights (  ,  + 
 	/// ) </para>
 	/// </summary>
-	vector<vector<double>> _tau, _eta_beta, _weights;
+	Matrix<double> _tau, _eta_beta, _weights;
 
 	/// <summary>
 	///     :
@@ -108,21 +166,426 @@ class ACOSolver : public TSPSolver
 	///     :
 	/// <para> - choices (   ) </para>
 	/// <para> - visited (    /     ) </para>
+	/// (   )
+	/// </summary>
+	Matrix<int> _choices, _visited;
+
+	/// <summary>
+	///       ( 
+	///   ,   )
+	/// </summary>
+	Arena _arena;
+
+	/// <summary>
+	///      
+	/// (Or-opt, Or-3opt)
+	/// </summary>
+	Neighbors _neighbors;
+
+	/// <summary>
+	///  :
+	/// <para> - lower_bound (   ; 0 - ) </para>
+	/// <para> - target_gap (    ) </para>
+	/// </summary>
+	int _lower_bound;
+	double _target_gap;
+
+	/// <summary>
+	///        ,
+	///   
+	/// </summary>
+	bool target_reached()
+	{
+		return _lower_bound > 0 && _len <= _lower_bound * (1 + _target_gap);
+	}
+
+	/// <summary>
+	///   (    
+	///   )
+	/// </summary>
+	CancellationToken _cancel;
+
+	/// <summary>
+	///    :     
+	/// </summary>
+	bool stop_requested()
+	{
+		return target_reached() || _cancel.cancelled();
+	}
+
+	/// <summary>
+	///    :
+	/// <para> - progress (;  -  ) </para>
+	/// <para> - reported_len (    ) </para>
+	/// <para> - start ( ) </para>
+	/// </summary>
+	ProgressCallback _progress;
+	int _reported_len;
+	steady_clock::time_point _start;
+
+	/// <summary>
+	///      (  )
+	/// </summary>
+	void report_progress()
+	{
+		if (!_progress || _len >= _reported_len) return;
+
+		_reported_len = _len;
+		_progress({ _iter, _len, duration<double>(steady_clock::now() - _start).count() });
+	}
+
+	/// <summary>
+	///    (   )
+	/// </summary>
+	int _iter;
+
+	/// <summary>
+	///      (MMAS):
+	/// <para> - since_restart (    ) </para>
+	/// <para> - since_improvement (    
+	///    ) </para>
+	/// <para> - restart_best_len (    ) </para>
+	/// </summary>
+	int _since_restart, _since_improvement, _restart_best_len;
+
+	/// <summary>
+	///  :
+	/// <para> - checkpoint_path ( ) </para>
+	/// <para> - checkpoint_interval (  ; 0 -  ) </para>
 	/// </summary>
-	vector<vector<int>> _choices, _visited;
+	string _checkpoint_path;
+	int _checkpoint_interval;
+
+	/// <summary>
+	///  :
+	/// <para> - warm_bias (       
+	///  tau0) </para>
+	/// </summary>
+	double _warm_bias;
+
+	/// <summary>
+	///    
+	/// </summary>
+	AffinityPolicy _affinity;
+
+	/// <summary>
+	///  :
+	/// <para> - reorder ( ) </para>
+	/// <para> - order (order[i] -    i;  -  ) </para>
+	/// <para> - rank (rank[v] -     v) </para>
+	/// <para> - reordered ( ,    ; 
+	///        ) </para>
+	/// </summary>
+	ReorderType _reorder;
+	vector<int> _order, _rank;
+	Graph _reordered;
+
+	/// <summary>
+	/// ,    :   
+	///   g,    g
+	/// </summary>
+	/// <param name="g">   </param>
+	/// <returns>   </returns>
+	Graph& reorder(Graph& g)
+	{
+		_order.clear();
+		_rank.clear();
+
+		if (_reorder == ReorderType::None) return g;
+
+		_order = locality_order(g, _reorder, _n_jobs);
+		_rank.resize(_order.size());
+
+		for (int i = 0; i < (int)_order.size(); ++i)
+			_rank[_order[i]] = i;
+
+		_reordered = permute(g, _order, _n_jobs);
+
+		return _reordered;
+	}
+
+	/// <summary>
+	///       
+	/// (  ,     reoptimize)
+	/// </summary>
+	void release_reordered()
+	{
+		_reordered = Graph();
+	}
+
+	/// <summary>
+	///    
+	/// </summary>
+	int internal(int v) { return _rank.empty() ? v : _rank[v]; }
+
+	/// <summary>
+	///         (to_original)
+	///  :       
+	/// </summary>
+	/// <param name="to_original">   </param>
+	void map_solution(bool to_original)
+	{
+		if (_order.empty()) return;
+
+		for (int& v : _solution)
+			v = to_original ? _order[v] : _rank[v];
+	}
+
+	/// <summary>
+	///    
+	/// </summary>
+	future<void> _checkpoint_job;
+
+	/// <summary>
+	///   
+	/// </summary>
+	static constexpr char checkpoint_magic[8] = { 'A', 'C', 'O', 'S', 'N', 'A', 'P', '3' };
+
+	/// <summary>
+	///     :  ,  ,
+	///   ,   ,  ,
+	/// tau_min / tau_max,  ,  (PACO), 
+	///         (
+	///  -   :   
+	///   ,        )
+	/// </summary>
+	string snapshot()
+	{
+		ostringstream out(ios::binary);
+
+		auto put = [&](const auto& value) { out.write((const char*)&value, sizeof(value)); };
+		auto put_tour = [&](const vector<int>& tour)
+		{
+			put((int)tour.size());
+			out.write((const char*)tour.data(), tour.size() * sizeof(int));
+		};
+
+		out.write(checkpoint_magic, sizeof(checkpoint_magic));
+
+		put((int)_type);
+		put(_n_cities);
+		put((int)_reorder);
+		put(_iter + 1);
+		put(_len);
+		put_tour(_solution);
+
+		put(_tau_min);
+		put(_tau_max);
+		put(_since_restart);
+		put(_since_improvement);
+		put(_restart_best_len);
+
+		put((int)_population.size());
+
+		for (vector<int>& tour : _population)
+			put_tour(tour);
+
+		//  :  0  ,
+		//    
+		vector<string> states(_n_jobs);
+
+		#pragma omp parallel num_threads(_n_jobs)
+		{
+			ostringstream rng;
+			rng << gen;
+
+			states[omp_get_thread_num()] = rng.str();
+		}
+
+		put(_n_jobs);
+
+		for (string& state : states)
+		{
+			put((int)state.size());
+			out.write(state.data(), state.size());
+		}
+
+		for (int i = 0; i < _n_cities; ++i)
+			out.write((const char*)_tau[i], _n_cities * sizeof(double));
+
+		return out.str();
+	}
+
+	/// <summary>
+	///    ,   : 
+	///   ,    ,  
+	///  .    (  )
+	/// </summary>
+	void checkpoint()
+	{
+		if (_checkpoint_interval == 0 || (_iter + 1) % _checkpoint_interval != 0) return;
+
+		if (_checkpoint_job.valid()) _checkpoint_job.get();
+
+		_checkpoint_job = async(launch::async, [path = _checkpoint_path, data = snapshot()]
+		{
+			string tmp = path + ".tmp";
+
+			{
+				ofstream out(tmp, ios::binary | ios::trunc);
+				out.write(data.data(), data.size());
+
+				if (!out) throw runtime_error("cannot write checkpoint: " + tmp);
+			}
+
+			//    :    
+			//     ,   
+#ifdef _WIN32
+			if (!MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+#else
+			if (rename(tmp.c_str(), path.c_str()) != 0)
+#endif
+				throw runtime_error("cannot write checkpoint: " + path);
+		});
+	}
+
+	/// <summary>
+	///    
+	/// </summary>
+	/// <param name="path">   </param>
+	/// <exception cref="runtime_error">         </exception>
+	void load_checkpoint(const string& path)
+	{
+		ifstream in(path, ios::binary);
+
+		if (!in.is_open()) throw runtime_error("cannot open checkpoint: " + path);
+
+		auto fail = [&](const string& what) { throw runtime_error("invalid checkpoint " + path + ": " + what); };
+
+		auto get = [&](auto& value)
+		{
+			in.read((char*)&value, sizeof(value));
+			if (!in) fail("unexpected end of file");
+		};
+
+		auto get_tour = [&](vector<int>& tour)
+		{
+			int size;
+			get(size);
+
+			if (size != 0 && size != _n_cities + 1) fail("tour size mismatch");
+
+			tour.resize(size);
+			in.read((char*)tour.data(), size * sizeof(int));
+			if (!in) fail("unexpected end of file");
+		};
+
+		char magic[sizeof(checkpoint_magic)];
+		in.read(magic, sizeof(magic));
+
+		if (!in || !equal(magic, magic + sizeof(magic), checkpoint_magic)) fail("not a checkpoint");
+
+		int type, n_cities, reorder_type;
+		get(type);
+		get(n_cities);
+		get(reorder_type);
+
+		if (type != (int)_type) fail("ACO type mismatch");
+		if (n_cities != _n_cities) fail("graph size mismatch");
+		if (reorder_type != (int)_reorder) fail("reorder mismatch");
+
+		get(_iter);
+		get(_len);
+		get_tour(_solution);
+
+		get(_tau_min);
+		get(_tau_max);
+		get(_since_restart);
+		get(_since_improvement);
+		get(_restart_best_len);
+
+		int pop_size;
+		get(pop_size);
+
+		if (pop_size < 0 || pop_size > _pop_size) fail("population size mismatch");
+
+		_population.resize(pop_size);
+
+		for (vector<int>& tour : _population)
+			get_tour(tour);
+
+		int n_jobs;
+		get(n_jobs);
+
+		if (n_jobs != _n_jobs) fail("thread count mismatch");
+
+		vector<string> states(n_jobs);
+
+		for (string& state : states)
+		{
+			int state_size;
+			get(state_size);
+
+			state.assign(state_size, '\0');
+			in.read(&state[0], state_size);
+			if (!in) fail("unexpected end of file");
+		}
+
+		#pragma omp parallel num_threads(_n_jobs)
+		{
+			istringstream rng(states[omp_get_thread_num()]);
+			rng >> gen;
+		}
+
+		for (int i = 0; i < _n_cities; ++i)
+		{
+			in.read((char*)_tau[i], _n_cities * sizeof(double));
+			if (!in) fail("unexpected end of file");
+		}
+	}
+
+	/// <summary>
+	///    .   ,  ,
+	///     (split_min_cities   ),
+	///    ,     
+	///     
+	/// </summary>
+	/// <typeparam name="TrackBest">   pos </typeparam>
+	/// <param name="g">  </param>
+	/// <param name="pos">     </param>
+	template <bool TrackBest>
+	void construct_solutions(Graph& g, vector<int>& pos)
+	{
+		if (_n_ants < _n_jobs && _n_cities >= (long long)_split_min_cities * _n_jobs)
+		{
+			for (int i = 0; i < _n_ants; ++i)
+			{
+				_ants[i].solve(g, _vertices[i], _visited[0], _choices[0], _weights, _n_jobs);
+
+				for (int j = 0; j < _n_cities; ++j)
+					_visited[0][j] = 0;
+
+				if (TrackBest && _ants[i] < _ants[pos[0]]) pos[0] = i;
+			}
+
+			return;
+		}
+
+		#pragma omp parallel for num_threads(_n_jobs)
+		for (int i = 0; i < _n_ants; ++i)
+		{
+			int thread_num = omp_get_thread_num();
+
+			_ants[i].solve(g, _vertices[i], _visited[thread_num], _choices[thread_num], _weights);
+
+			for (int j = 0; j < _n_cities; ++j)
+				_visited[thread_num][j] = 0;
+
+			if (TrackBest && _ants[i] < _ants[pos[thread_num]]) pos[thread_num] = i;
+		}
+	}
 
 	/// <summary>
 	/// (Elitist) Ant System
 	/// </summary>
+	/// <typeparam name="Elitist">    (EAS) </typeparam>
 	/// <param name="g">  </param>
+	template <bool Elitist>
 	void elitist_ant_system(Graph& g)
 	{
-		for (int it = 0; it < _max_iter; ++it)
+		for (; _iter < _max_iter && !stop_requested(); ++_iter)
 		{
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_cities; ++i)
-				for (int j = 0; j < _n_cities; ++j)
-					_weights[i][j] = pow(_tau[i][j], _alpha) * _eta_beta[i][j];
+			update_weights(_weights, _tau, _eta_beta, _alpha, _n_jobs);
 
 			//   
 			shuffle(_vertices.begin(), _vertices.end(), gen);
@@ -131,18 +594,7 @@ class ACOSolver : public TSPSolver
 			vector<int> pos(_n_jobs);
 
 			//   	
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_ants; ++i)
-			{
-				int thread_num = omp_get_thread_num();
-
-				_ants[i].solve(g, _vertices[i], _visited[thread_num], _choices[thread_num], _weights);
-
-				for (int j = 0; j < _n_cities; ++j)
-					_visited[thread_num][j] = 0;
-
-				if (_ants[i] < _ants[pos[thread_num]]) pos[thread_num] = i;
-			}
+			construct_solutions<true>(g, pos);
 
 			for (int i = 0; i < _n_jobs; ++i)
 				if (_ants[pos[i]].len() < _len)
@@ -152,10 +604,7 @@ class ACOSolver : public TSPSolver
 				}
 
 			//   
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_cities; ++i)
-				for (int j = 0; j < _n_cities; ++j)
-					_tau[i][j] *= (1 - _rho); 
+			evaporate(_tau, _rho, _n_jobs);
 
 			//      
 			for (int i = 0; i < _n_ants; ++i)
@@ -163,20 +612,19 @@ class ACOSolver : public TSPSolver
 				vector<int> solution = _ants[i].solution();
 				double w = 1.0 / _ants[i].len();
 
-				#pragma omp parallel for 
-				for (int j = 0; j < _n_cities; ++j)
-					_tau[solution[j]][solution[j + 1]] += w;
+				deposit_tour(_tau, solution, w, _n_jobs);
 			}
 
 			//     
-			if (_type == "EAS")
+			if constexpr (Elitist)
 			{
 				double w = (double)_w / _len;
 
-				#pragma omp parallel for
-				for (int j = 0; j < _n_cities; ++j)
-					_tau[_solution[j]][_solution[j + 1]] += w;
+				deposit_tour(_tau, _solution, w, _n_jobs);
 			}
+
+			checkpoint();
+			report_progress();
 		}
 	}
 
@@ -186,12 +634,9 @@ class ACOSolver : public TSPSolver
 	/// <param name="g">  </param>
 	void rank_based_ant_system(Graph& g)
 	{
-		for (int it = 0; it < _max_iter; ++it)
+		for (; _iter < _max_iter && !stop_requested(); ++_iter)
 		{
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_cities; ++i)
-				for (int j = 0; j < _n_cities; ++j)
-					_weights[i][j] = pow(_tau[i][j], _alpha) * _eta_beta[i][j];
+			update_weights(_weights, _tau, _eta_beta, _alpha, _n_jobs);
 
 			//   
 			shuffle(_vertices.begin(), _vertices.end(), gen);
@@ -200,18 +645,7 @@ class ACOSolver : public TSPSolver
 			vector<int> pos(_n_jobs);
 
 			//   	
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_ants; ++i)
-			{
-				int thread_num = omp_get_thread_num();
-
-				_ants[i].solve(g, _vertices[i], _visited[thread_num], _choices[thread_num], _weights);
-
-				for (int j = 0; j < _n_cities; ++j)
-					_visited[thread_num][j] = 0;
-
-				if (_ants[i] < _ants[pos[thread_num]]) pos[thread_num] = i;
-			}
+			construct_solutions<true>(g, pos);
 
 			for (int i = 0; i < _n_jobs; ++i)
 				if (_ants[pos[i]].len() < _len)
@@ -221,10 +655,7 @@ class ACOSolver : public TSPSolver
 				}
 
 			//   
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_cities; ++i)
-				for (int j = 0; j < _n_cities; ++j)
-					_tau[i][j] *= (1 - _rho);
+			evaporate(_tau, _rho, _n_jobs);
 
 			//     
 			sort(_ants.begin(), _ants.end());
@@ -235,37 +666,35 @@ class ACOSolver : public TSPSolver
 				vector<int> solution = _ants[i].solution();
 				double w = (_w - i - 1.0) / _ants[i].len();
 
-				#pragma omp parallel for 
-				for (int j = 0; j < _n_cities; ++j)
-					_tau[solution[j]][solution[j + 1]] += w;
+				deposit_tour(_tau, solution, w, _n_jobs);
 			}
 
 			//   
 			double w = (double)_w / _len;
 
-			#pragma omp parallel for
-			for (int j = 0; j < _n_cities; ++j)
-				_tau[_solution[j]][_solution[j + 1]] += w;
+			deposit_tour(_tau, _solution, w, _n_jobs);
+
+			checkpoint();
+			report_progress();
 		}
 	}
 
 	/// <summary>
 	/// Max-Min Ant System
 	/// </summary>
+	/// <typeparam name="LS">    </typeparam>
 	/// <param name="g">  </param>
+	template <LocalSearchType LS>
 	void max_min_ant_system(Graph& g)
 	{
-		_tau_max = _tau0;
-		_tau_min = _a * _tau_max;
+		//   (  fout   )
+		ostringstream iter_time;
 
-		for (int it = 0; it < _max_iter; ++it)
+		for (; _iter < _max_iter && !stop_requested(); ++_iter)
 		{
 			system_clock::time_point start = system_clock::now();
 
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_cities; ++i)
-				for (int j = 0; j < _n_cities; ++j)
-					_weights[i][j] = pow(_tau[i][j], _alpha) * _eta_beta[i][j];
+			update_weights(_weights, _tau, _eta_beta, _alpha, _n_jobs);
 
 			//   
 			shuffle(_vertices.begin(), _vertices.end(), gen);
@@ -274,157 +703,623 @@ class ACOSolver : public TSPSolver
 			vector<KOptSolver> ls_ants(_k);
 
 			//    
-			vector<int> pos(_n_jobs);
+			vector<int> pos(_n_jobs), ib_solution;
+			int ib_len = INF;
 
 			//   	
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_ants; ++i)
-			{
-				int thread_num = omp_get_thread_num();
-
-				_ants[i].solve(g, _vertices[i], _visited[thread_num], _choices[thread_num], _weights);
-
-				for (int j = 0; j < _n_cities; ++j)
-					_visited[thread_num][j] = 0;
-
-				if (_local_search_type == "None" && _ants[i] < _ants[pos[thread_num]]) 
-					pos[thread_num] = i;
-			}
+			construct_solutions<LS == LocalSearchType::None>(g, pos);
 
 			//     
-			if (_local_search_type != "None")
+			if constexpr (LS != LocalSearchType::None)
 			{
-				if (_local_search_tours == "k-best") sort(_ants.begin(), _ants.end());
+				if (_local_search_tours == LocalSearchTours::KBest) sort(_ants.begin(), _ants.end());
 				else shuffle(_ants.begin(), _ants.end(), gen);
 
-				#pragma omp parallel for 
+				#pragma omp parallel for num_threads(_n_jobs)
 				for (int i = 0; i < _k; ++i)
 				{
 					int thread_num = omp_get_thread_num();
 
-					ls_ants[i].solve(g, _local_search_type, _ants[i].solution(), _ants[i].len());
+					ls_ants[i].set_cancel_token(_cancel);
+					ls_ants[i].solve<LS>(g, _ants[i].solution(), _ants[i].len(), &_neighbors);
 
 					if (ls_ants[i] < ls_ants[pos[thread_num]]) pos[thread_num] = i;
 				}
 
-				//   
+				//    
 				for (int i = 0; i < _n_jobs; ++i)
-					if (ls_ants[pos[i]].len() < _len)
+					if (ls_ants[pos[i]].len() < ib_len)
 					{
-						_solution = ls_ants[pos[i]].solution();
-						_len = ls_ants[pos[i]].len();
+						ib_solution = ls_ants[pos[i]].solution();
+						ib_len = ls_ants[pos[i]].len();
 					}
 			}
 			else
 			{
-				//   
+				//    
 				for (int i = 0; i < _n_jobs; ++i)
-					if (_ants[pos[i]].len() < _len)
+					if (_ants[pos[i]].len() < ib_len)
 					{
-						_solution = _ants[pos[i]].solution();
-						_len = _ants[pos[i]].len();
+						ib_solution = _ants[pos[i]].solution();
+						ib_len = _ants[pos[i]].len();
 					}
 			}
+
+			//   
+			if (ib_len < _len)
+			{
+				_solution = ib_solution;
+				_len = ib_len;
+			}
+
+			if (ib_len < _restart_best_len)
+			{
+				_restart_best_len = ib_len;
+				_since_improvement = 0;
+			}
+			else ++_since_improvement;
 			
 			_tau_max = 1.0 / _rho / _len;
 			_tau_min = _a * _tau_max;
 
-			//   
-			#pragma omp parallel for 
-			for (int i = 0; i < _n_cities; ++i)
-				for (int j = 0; j < _n_cities; ++j)
-					_tau[i][j] = max(_tau_min, _tau[i][j] * (1 - _rho));
+			//  ;     
+			// lambda-    
+			int branching = 0;
 
-			//   
-			double w = 1.0 / _len;
+			if (_restart_bf > 0) branching = evaporate_branching(_tau, _rho, _tau_min, _lambda, _n_jobs);
+			else evaporate_clamped(_tau, _rho, _tau_min, _n_jobs);
 
-			#pragma omp parallel for 
-			for (int j = 0; j < _n_cities; ++j)
-				_tau[_solution[j]][_solution[j + 1]] = min(_tau_max, _tau[_solution[j]][_solution[j + 1]] + w);
+			// :    tau_max
+			if (_restart_bf > 0 && (double)branching / _n_cities < _restart_bf && _since_improvement >= _restart_wait)
+			{
+				#pragma omp parallel for num_threads(_n_jobs)
+				for (int i = 0; i < _n_cities; ++i)
+					for (int j = 0; j < _n_cities; ++j)
+						_tau[i][j] = _tau_max;
+
+				_since_restart = _since_improvement = 0;
+				_restart_best_len = INF;
+			}
+			else
+			{
+				//   :     
+				//    ,  -  ,  
+				//   
+				int u_gb = _since_restart < 25 ? 0 : _since_restart < 75 ? 5 : _since_restart < 125 ? 3 : _since_restart < 250 ? 2 : 1;
+				++_since_restart;
+
+				bool use_ib = _restart_bf > 0 && (u_gb == 0 || _since_restart % u_gb != 0);
+
+				vector<int>& best = use_ib ? ib_solution : _solution;
+				double w = 1.0 / (use_ib ? ib_len : _len);
+
+				deposit_tour_clamped(_tau, best, w, _tau_max, _n_jobs);
+			}
 
 			system_clock::time_point end = system_clock::now();
 			duration <double> delta = end - start;
 
-			fout << delta.count() << " ";
+			iter_time << delta.count() << " ";
+
+			checkpoint();
+			report_progress();
 		}
 
-		fout << "\n";
+		lock_guard<mutex> lock(fout_mutex);
+		fout << iter_time.str() << "\n";
 	}
 
-public:
+	/// <summary>
+	///       
+	///    
+	/// </summary>
+	/// <param name="solution">  </param>
+	/// <param name="w">    </param>
+	void deposit(vector<int>& solution, double w)
+	{
+		#pragma omp parallel for num_threads(_n_jobs)
+		for (int j = 0; j < _n_cities; ++j)
+		{
+			int from = solution[j], to = solution[j + 1];
+
+			_tau[from][to] = max(_tau0, _tau[from][to] + w);
+			_weights[from][to] = pow(_tau[from][to], _alpha) * _eta_beta[from][to];
+		}
+	}
 
 	/// <summary>
-	/// 
+	/// Population-based Ant Colony Optimization:   
+	///  tau0    ,  .
+	///  ,     
+	///     
 	/// </summary>
-	/// <param name="type">    </param>
-	/// <param name="params">    </param>
-	ACOSolver(string type, map<string, any> params) : _type(type)
+	/// <param name="g">  </param>
+	void population_based_ant_system(Graph& g)
 	{
-		//  
-		_alpha = any_cast<double>(params["alpha"]);
-		_beta = any_cast<double>(params["beta"]);
-		_rho = any_cast<double>(params["rho"]);
-		_tau0 = any_cast<double>(params["tau0"]);
-		
-		//  
-		_n_ants = any_cast<int>(params["n_ants"]);
-		_max_iter = any_cast<int>(params["max_iter"]);
-		_n_jobs = any_cast<int>(params["n_jobs"]);
+		//    
+		double w = _w * _tau0 / _pop_size;
 
-		//     
-		if (type == "EAS" || type == "ASRank") _w = any_cast<int>(params["w"]);
+		update_weights(_weights, _tau, _eta_beta, _alpha, _n_jobs);
 
-		//     
-		if (type == "MMAS")
+		for (; _iter < _max_iter && !stop_requested(); ++_iter)
 		{
-			_a = any_cast<double>(params["a"]);
+			//   
+			shuffle(_vertices.begin(), _vertices.end(), gen);
+
+			//    
+			vector<int> pos(_n_jobs);
+
+			//   	
+			construct_solutions<true>(g, pos);
+
+			int best = pos[0];
+
+			for (int i = 1; i < _n_jobs; ++i)
+				if (_ants[pos[i]] < _ants[best]) best = pos[i];
 
-			_local_search_type = any_cast<string>(params["local_search_type"]);
+			if (_ants[best].len() < _len)
+			{
+				_solution = _ants[best].solution();
+				_len = _ants[best].len();
+			}
 
-			//       
-			if (_local_search_type != "None")
+			//     
+			if ((int)_population.size() == _pop_size)
 			{
-				_local_search_tours = any_cast<string>(params["local_search_tours"]);
-				_k = any_cast<int>(params["k"]);
+				deposit(_population.front(), -w);
+				_population.pop_front();
 			}
+
+			//       
+			_population.push_back(_ants[best].solution());
+			deposit(_population.back(), w);
+
+			checkpoint();
+			report_progress();
 		}
 	}
 
 	/// <summary>
-	///  
+	/// Ant Colony System:     
+	///        
+	/// (    ),  
+	///     (O(n)  )
 	/// </summary>
 	/// <param name="g">  </param>
-	void solve(Graph& g)
+	void ant_colony_system(Graph& g)
+	{
+		update_weights(_weights, _tau, _eta_beta, _alpha, _n_jobs);
+
+		for (; _iter < _max_iter && !stop_requested(); ++_iter)
+		{
+			//   
+			shuffle(_vertices.begin(), _vertices.end(), gen);
+
+			//    
+			vector<int> pos(_n_jobs);
+
+			//   	
+			#pragma omp parallel for num_threads(_n_jobs)
+			for (int i = 0; i < _n_ants; ++i)
+			{
+				int thread_num = omp_get_thread_num();
+
+				_ants[i].solve(g, _vertices[i], _visited[thread_num], _choices[thread_num], _weights, _q0);
+
+				for (int j = 0; j < _n_cities; ++j)
+					_visited[thread_num][j] = 0;
+
+				if (_ants[i] < _ants[pos[thread_num]]) pos[thread_num] = i;
+			}
+
+			for (int i = 0; i < _n_jobs; ++i)
+				if (_ants[pos[i]].len() < _len)
+				{
+					_solution = _ants[pos[i]].solution();
+					_len = _ants[pos[i]].len();
+				}
+
+			//  : ,  , 
+			//     (   
+			//   ,  )
+			for (int i = 0; i < _n_ants; ++i)
+			{
+				vector<int> tour = _ants[i].solution();
+
+				for (int j = 0; j < _n_cities; ++j)
+				{
+					int from = tour[j], to = tour[j + 1];
+
+					_tau[from][to] = (1 - _xi) * _tau[from][to] + _xi * _tau0;
+					_weights[from][to] = pow(_tau[from][to], _alpha) * _eta_beta[from][to];
+				}
+			}
+
+			//  :    
+			#pragma omp parallel for num_threads(_n_jobs)
+			for (int j = 0; j < _n_cities; ++j)
+			{
+				int from = _solution[j], to = _solution[j + 1];
+
+				_tau[from][to] = (1 - _rho) * _tau[from][to] + _rho / _len;
+				_weights[from][to] = pow(_tau[from][to], _alpha) * _eta_beta[from][to];
+			}
+
+			checkpoint();
+			report_progress();
+		}
+	}
+
+	/// <summary>
+	///          g
+	/// </summary>
+	/// <param name="g">  </param>
+	void prepare(Graph& g)
 	{
 		//  :
 
 		_len = INF;
 		_n_cities = g.n();
-		omp_set_num_threads(_n_jobs);
+		_solution.clear();
+
+		//      ,  
+		//   solve (  ,   
+		//  ).   ,   
+		//    (    )
+		_arena.reserve(3 * Matrix<double>::bytes(_n_cities, _n_cities) + 2 * Matrix<int>::bytes(_n_jobs, _n_cities));
 
-		_tau = vector<vector<double>>(_n_cities, vector<double>(_n_cities, _tau0));
-		_eta_beta = vector<vector<double>>(_n_cities, vector<double>(_n_cities));
-		_weights = vector<vector<double>>(_n_cities, vector<double>(_n_cities));
+		_tau = _arena.matrix<double>(_n_cities, _n_cities);
+		_eta_beta = _arena.matrix<double>(_n_cities, _n_cities);
+		_weights = _arena.matrix<double>(_n_cities, _n_cities);
 
-		#pragma omp parallel for
+		#pragma omp parallel for num_threads(_n_jobs) schedule(static)
 		for (int i = 0; i < _n_cities; ++i)
 			for (int j = 0; j < _n_cities; ++j)
+			{
+				_tau[i][j] = _tau0;
 				_eta_beta[i][j] = pow(g[i][j], -_beta);
+				_weights[i][j] = 0;
+			}
 
-		_vertices = vector<int>(_n_cities);
+		_vertices.resize(_n_cities);
 
-		#pragma omp parallel for
 		for (int i = 0; i < _n_cities; ++i)
 			_vertices[i] = i;
 
-		_ants = vector<Ant>(_n_ants);
+		_ants.resize(_n_ants);
+
+		_choices = _arena.matrix<int>(_n_jobs, _n_cities);
+		_visited = _arena.matrix<int>(_n_jobs, _n_cities);
+
+		//      
+		#pragma omp parallel num_threads(_n_jobs)
+		{
+			int thread_num = omp_get_thread_num();
+
+			for (int j = 0; j < _n_cities; ++j)
+				_choices[thread_num][j] = _visited[thread_num][j] = 0;
+		}
+
+		if (_local_search_type == LocalSearchType::OrOpt || _local_search_type == LocalSearchType::OrThreeOpt)
+			_neighbors = Neighbors(g, 10, _n_jobs);
+
+		//  
+		_iter = 0;
+		_tau_max = _tau0;
+		_tau_min = _a * _tau_max;
+		_since_restart = _since_improvement = 0;
+		_restart_best_len = INF;
+		_population.clear();
+	}
+
+	/// <summary>
+	///  ,   _iter
+	/// </summary>
+	/// <param name="g">  </param>
+	void run(Graph& g)
+	{
+		_start = steady_clock::now();
+		_reported_len = INF;
+
+		//        :
+		//       
+		switch (_type)
+		{
+		case ACOType::AS: elitist_ant_system<false>(g); break;
+		case ACOType::EAS: elitist_ant_system<true>(g); break;
+		case ACOType::ASRank: rank_based_ant_system(g); break;
+		case ACOType::PACO: population_based_ant_system(g); break;
+		case ACOType::ACS: ant_colony_system(g); break;
+		case ACOType::MMAS:
+			switch (_local_search_type)
+			{
+			case LocalSearchType::None: max_min_ant_system<LocalSearchType::None>(g); break;
+			case LocalSearchType::TwoOpt: max_min_ant_system<LocalSearchType::TwoOpt>(g); break;
+			case LocalSearchType::TwoHalfOpt: max_min_ant_system<LocalSearchType::TwoHalfOpt>(g); break;
+			case LocalSearchType::ThreeOpt: max_min_ant_system<LocalSearchType::ThreeOpt>(g); break;
+			case LocalSearchType::OrOpt: max_min_ant_system<LocalSearchType::OrOpt>(g); break;
+			case LocalSearchType::OrThreeOpt: max_min_ant_system<LocalSearchType::OrThreeOpt>(g); break;
+			}
+			break;
+		}
+
+		//    
+		if (_checkpoint_job.valid()) _checkpoint_job.get();
+	}
+
+public:
+
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="config">   </param>
+	/// <exception cref="invalid_argument">    </exception>
+	ACOSolver(const ACOConfig& config) { configure(config); }
+
+	/// <summary>
+	///    .  
+	///       solve
+	/// </summary>
+	/// <param name="config">   </param>
+	/// <exception cref="invalid_argument">    </exception>
+	void configure(const ACOConfig& config)
+	{
+		config.validate();
+
+		_type = config.type;
+
+		//  
+		_alpha = config.alpha;
+		_beta = config.beta;
+		_rho = config.rho;
+		_tau0 = config.tau0;
+
+		//  
+		_n_ants = config.n_ants;
+		_max_iter = config.max_iter;
+		_n_jobs = config.n_jobs;
+		_split_min_cities = config.split_min_cities;
+
+		//       
+		_w = config.w;
+		_pop_size = config.pop_size;
+
+		//     
+		_q0 = config.q0;
+		_xi = config.xi;
+
+		//     
+		_a = config.a;
+		_restart_bf = config.restart_bf;
+		_lambda = config.lambda;
+		_restart_wait = config.restart_wait;
+
+		_local_search_type = _type == ACOType::MMAS ? config.local_search_type : LocalSearchType::None;
+		_local_search_tours = config.local_search_tours;
+		_k = _local_search_type != LocalSearchType::None ? config.k : 0;
+
+		//  
+		_lower_bound = config.lower_bound;
+		_target_gap = config.target_gap;
+
+		//  
+		_checkpoint_path = config.checkpoint_path;
+		_checkpoint_interval = config.checkpoint_interval;
+
+		//  
+		_warm_bias = config.warm_bias;
+
+		//  
+		_affinity = config.affinity;
+
+		//  
+		_reorder = config.reorder;
+	}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="type">    </param>
+	/// <param name="params">    </param>
+	/// <exception cref="invalid_argument">      </exception>
+	ACOSolver(string type, map<string, any> params) : ACOSolver(ACOConfig::from_map(type, params)) {}
+
+	/// <summary>
+	///   :    ,
+	///     (   
+	///  ,    len() == INF)
+	/// </summary>
+	/// <param name="token">   </param>
+	void set_cancel_token(CancellationToken token) { _cancel = token; }
+
+	/// <summary>
+	///       
+	/// (   ,    )
+	/// </summary>
+	/// <param name="progress">  ( -  ) </param>
+	void set_progress_callback(ProgressCallback progress) { _progress = progress; }
+
+	/// <summary>
+	///  
+	/// </summary>
+	/// <param name="g">  </param>
+	void solve(Graph& g)
+	{
+		//       (prepare),
+		//      
+		PinnedThreads pinned(_affinity, _n_jobs);
+
+		Graph& h = reorder(g);
+
+		prepare(h);
+		run(h);
+		map_solution(true);
+		release_reordered();
+	}
+
+	/// <summary>
+	///     :    
+	///   (    ),   
+	///    warm_bias * tau0.   
+	///       (. tau())
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="init_sol">   ( -  ) </param>
+	/// <param name="init_tau">    ( - tau0) </param>
+	/// <exception cref="invalid_argument">        </exception>
+	void solve(Graph& g, const vector<int>& init_sol, const vector<vector<double>>& init_tau = {})
+	{
+		//       (prepare),
+		//      
+		PinnedThreads pinned(_affinity, _n_jobs);
+
+		Graph& h = reorder(g);
+
+		prepare(h);
+
+		if (!init_tau.empty())
+		{
+			bool ok = (int)init_tau.size() == _n_cities;
+
+			for (int i = 0; ok && i < _n_cities; ++i)
+				ok = (int)init_tau[i].size() == _n_cities;
+
+			if (!ok) throw invalid_argument("warm start: pheromone matrix size mismatch");
+
+			#pragma omp parallel for num_threads(_n_jobs) schedule(static)
+			for (int i = 0; i < _n_cities; ++i)
+				for (int j = 0; j < _n_cities; ++j)
+					_tau[internal(i)][internal(j)] = init_tau[i][j];
+		}
+
+		if (!init_sol.empty())
+		{
+			vector<char> seen(_n_cities, 0);
+
+			bool ok = (int)init_sol.size() == _n_cities + 1 && init_sol[0] == init_sol[_n_cities];
+
+			for (int i = 0; ok && i < _n_cities; ++i)
+			{
+				ok = init_sol[i] >= 0 && init_sol[i] < _n_cities && !seen[init_sol[i]];
+				if (ok) seen[init_sol[i]] = 1;
+			}
+
+			if (!ok) throw invalid_argument("warm start: not a tour of this graph");
+
+			_solution = init_sol;
+			_len = 0;
+
+			map_solution(false);
+
+			for (int j = 0; j < _n_cities; ++j)
+			{
+				int from = _solution[j], to = _solution[j + 1];
+
+				_len += h[from][to];
+				_tau[from][to] = max(_tau[from][to], _warm_bias * _tau0);
+			}
+
+			_tau_max = max(_tau_max, _warm_bias * _tau0);
+		}
+
+		run(h);
+		map_solution(true);
+		release_reordered();
+	}
+
+	/// <summary>
+	///      :  
+	///         .
+	///          
+	/// </summary>
+	/// <param name="g">  () </param>
+	/// <param name="from">   </param>
+	/// <param name="to">   </param>
+	/// <param name="len">    </param>
+	void update_edge(Graph& g, int from, int to, int len)
+	{
+		int old_len = g[from][to];
+		g[from][to] = len;
+
+		//    
+		if (_n_cities != g.n() || _eta_beta.rows() != _n_cities) return;
+
+		//         reoptimize
+		int i = internal(from), j = internal(to);
+
+		_eta_beta[i][j] = pow(len, -_beta);
+		_weights[i][j] = pow(_tau[i][j], _alpha) * _eta_beta[i][j];
+
+		if (_solution.empty()) return;
+
+		for (int p = 0; p < _n_cities; ++p)
+			if (_solution[p] == from && _solution[p + 1] == to)
+				_len += len - old_len;
+	}
+
+	/// <summary>
+	///      (. update_edge):
+	///       ,
+	///     (  
+	///        )
+	/// </summary>
+	/// <param name="g">  ( ,     ) </param>
+	void reoptimize(Graph& g)
+	{
+		assert(_n_cities == g.n() && !_solution.empty());
+
+		_iter = 0;
+		_since_restart = _since_improvement = 0;
+		_restart_best_len = INF;
+
+		if (!_order.empty()) _reordered = permute(g, _order, _n_jobs);
+
+		map_solution(false);
+		run(_order.empty() ? g : _reordered);
+		map_solution(true);
+		release_reordered();
+	}
+
+	/// <summary>
+	///      (  )
+	/// </summary>
+	vector<vector<double>> tau()
+	{
+		vector<vector<double>> tau(_n_cities);
+
+		for (int i = 0; i < _n_cities; ++i)
+		{
+			tau[i].resize(_n_cities);
+
+			for (int j = 0; j < _n_cities; ++j)
+				tau[i][j] = _tau[internal(i)][internal(j)];
+		}
+
+		return tau;
+	}
+
+	/// <summary>
+	///       
+	/// ( ,    n_jobs,    
+	///  ).      
+	///   OpenMP
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="path">   </param>
+	/// <exception cref="runtime_error">         </exception>
+	void resume(Graph& g, const string& path)
+	{
+		//       (prepare),
+		//      
+		PinnedThreads pinned(_affinity, _n_jobs);
 
-		_choices = vector<vector<int>>(_n_jobs, vector<int>(_n_cities));
-		_visited = vector<vector<int>>(_n_jobs, vector<int>(_n_cities));
+		Graph& h = reorder(g);
 
-		if (_type == "AS" || _type == "EAS") elitist_ant_system(g);
-		else if (_type == "ASRank") rank_based_ant_system(g);
-		else if (_type == "MMAS") max_min_ant_system(g);
+		prepare(h);
+		load_checkpoint(path);
+		run(h);
+		map_solution(true);
+		release_reordered();
 	}
 
 	/// <summary>
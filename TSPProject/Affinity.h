@@ -0,0 +1,181 @@
+#pragma once
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <omp.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+/// <summary>
+///     :
+/// <para> - None (  ) </para>
+/// <para> - Compact ( t -   t:  
+///    NUMA,  ) </para>
+/// <para> - Scatter (     ,
+///  ,     NUMA) </para>
+/// </summary>
+enum class AffinityPolicy { None, Compact, Scatter };
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="name"> : none, compact, scatter </param>
+/// <returns>    </returns>
+AffinityPolicy to_affinity_policy(const string& name)
+{
+	if (name == "none") return AffinityPolicy::None;
+	if (name == "compact") return AffinityPolicy::Compact;
+	if (name == "scatter") return AffinityPolicy::Scatter;
+
+	throw invalid_argument("unknown affinity policy: " + name);
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="policy">    </param>
+/// <returns> : none, compact, scatter </returns>
+string to_string(AffinityPolicy policy)
+{
+	switch (policy)
+	{
+	case AffinityPolicy::Compact: return "compact";
+	case AffinityPolicy::Scatter: return "scatter";
+	default: return "none";
+	}
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="cpu">    </param>
+/// <returns>     </returns>
+bool pin_thread(int cpu)
+{
+#ifdef _WIN32
+	if (cpu >= (int)sizeof(DWORD_PTR) * 8) return false;
+
+	return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#else
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
+
+/// <summary>
+///    t  n   
+/// </summary>
+/// <param name="policy">    </param>
+/// <param name="t">   </param>
+/// <param name="n">   </param>
+/// <returns>    </returns>
+int affinity_cpu(AffinityPolicy policy, int t, int n)
+{
+	int n_cpus = max(1u, thread::hardware_concurrency());
+
+	if (policy == AffinityPolicy::Scatter && n < n_cpus)
+		return (int)((long long)t * n_cpus / n);
+
+	return t % n_cpus;
+}
+
+/// <summary>
+///    OpenMP  n_jobs .  OpenMP
+///      ,  
+///        num_threads(n_jobs).
+///     : ,  
+/// ,     NUMA.    :
+///  ,     (BatchSolver,
+/// Tuner)       0
+/// </summary>
+/// <param name="policy">    </param>
+/// <param name="n_jobs">   </param>
+void pin_omp_threads(AffinityPolicy policy, int n_jobs)
+{
+	if (policy == AffinityPolicy::None || n_jobs == 1) return;
+
+	#pragma omp parallel num_threads(n_jobs)
+	pin_thread(affinity_cpu(policy, omp_get_thread_num(), n_jobs));
+}
+
+/// <summary>
+///    OpenMP   :  
+/// ( 0 )      
+///  .      OpenMP
+///      
+/// </summary>
+class PinnedThreads
+{
+	/// <summary>
+	///     
+	/// </summary>
+#ifdef _WIN32
+	DWORD_PTR _mask = 0;
+#else
+	cpu_set_t _mask;
+#endif
+
+	/// <summary>
+	///    
+	/// </summary>
+	bool _pinned = false;
+
+public:
+
+	/// <summary>
+	/// :     
+	///    (. pin_omp_threads)
+	/// </summary>
+	/// <param name="policy">    </param>
+	/// <param name="n_jobs">   </param>
+	PinnedThreads(AffinityPolicy policy, int n_jobs)
+	{
+		if (policy == AffinityPolicy::None || n_jobs == 1) return;
+
+#ifdef _WIN32
+		DWORD_PTR process, system;
+
+		if (!GetProcessAffinityMask(GetCurrentProcess(), &process, &system)) return;
+
+		_mask = SetThreadAffinityMask(GetCurrentThread(), process);
+
+		if (_mask == 0) return;
+#else
+		if (pthread_getaffinity_np(pthread_self(), sizeof(_mask), &_mask) != 0) return;
+#endif
+
+		pin_omp_threads(policy, n_jobs);
+		_pinned = true;
+	}
+
+	PinnedThreads(const PinnedThreads&) = delete;
+	PinnedThreads& operator = (const PinnedThreads&) = delete;
+
+	~PinnedThreads()
+	{
+		if (!_pinned) return;
+
+#ifdef _WIN32
+		SetThreadAffinityMask(GetCurrentThread(), _mask);
+#else
+		pthread_setaffinity_np(pthread_self(), sizeof(_mask), &_mask);
+#endif
+	}
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "TSPSolver.h"
+#include "Arena.h"
 
 /// <summary>
 ///  
@@ -13,7 +14,7 @@ class Ant : public TSPSolver
 	/// <param name="tau_alpha">  ,     alpha </param>
 	/// <param name="eta">     beta </param>
 	/// <returns>   </returns>
-	int next(vector<int>& visited, vector<int>& choices, vector<double>& weights)
+	int next(int* visited, int* choices, double* weights)
 	{
 		int pos = 0;
 		double sum = 0;
@@ -32,6 +33,110 @@ class Ant : public TSPSolver
 		for (int i = 0; i < pos; ++i)
 			if (rnd > weights[choices[i]]) rnd -= weights[choices[i]];
 			else return choices[i];
+
+		// -   rnd    
+		return choices[pos - 1];
+	}
+
+	/// <summary>
+	///      weights,
+	///    ( next_parallel)
+	/// </summary>
+	vector<double> _partial;
+
+	/// <summary>
+	///     :  
+	///      ( ),
+	///       ,
+	///     ,      
+	/// </summary>
+	/// <param name="visited">     /      </param>
+	/// <param name="weights">     </param>
+	/// <param name="n_threads">   </param>
+	/// <returns>   </returns>
+	int next_parallel(int* visited, double* weights, int n_threads)
+	{
+		int n_parts = 1;
+
+		#pragma omp parallel num_threads(n_threads)
+		{
+			int t = omp_get_thread_num();
+
+			#pragma omp single
+			{
+				n_parts = omp_get_num_threads();
+				_partial.resize(n_parts + 1);
+			}
+
+			int lo = (long long)_n_cities * t / n_parts;
+			int hi = (long long)_n_cities * (t + 1) / n_parts;
+
+			double sum = 0;
+
+			// omp simd - OpenMP 4.0 ( MSVC /openmp, OpenMP 2.0, 
+			//   )
+#if _OPENMP >= 201307
+			#pragma omp simd reduction(+ : sum)
+#endif
+			for (int i = lo; i < hi; ++i)
+				sum += visited[i] ? 0.0 : weights[i];
+
+			_partial[t + 1] = sum;
+		}
+
+		//    
+		_partial[0] = 0;
+
+		for (int t = 0; t < n_parts; ++t)
+			_partial[t + 1] += _partial[t];
+
+		//    
+		uniform_real_distribution <double> interval_double(0, _partial[n_parts]);
+		double rnd = interval_double(gen);
+
+		int t = upper_bound(_partial.begin() + 1, _partial.begin() + n_parts, rnd) - _partial.begin() - 1;
+		rnd -= _partial[t];
+
+		int lo = (long long)_n_cities * t / n_parts;
+		int hi = (long long)_n_cities * (t + 1) / n_parts;
+		int last = -1;
+
+		for (int i = lo; i < hi; ++i)
+			if (!visited[i])
+			{
+				if (rnd <= weights[i]) return i;
+
+				rnd -= weights[i];
+				last = i;
+			}
+
+		// -   rnd    
+		if (last != -1) return last;
+
+		for (int i = _n_cities - 1; ; --i)
+			if (!visited[i]) return i;
+	}
+
+	/// <summary>
+	///    (ACS):   q0
+	///     ,  -   next
+	/// </summary>
+	/// <param name="q0">    </param>
+	/// <returns>   </returns>
+	int next_acs(int* visited, int* choices, double* weights, double q0)
+	{
+		uniform_real_distribution <double> interval_double(0, 1);
+
+		if (interval_double(gen) >= q0)
+			return next(visited, choices, weights);
+
+		int best = -1;
+
+		for (int i = 0; i < _n_cities; ++i)
+			if (!visited[i] && (best == -1 || weights[i] > weights[best]))
+				best = i;
+
+		return best;
 	}
 
 public:
@@ -43,7 +148,8 @@ public:
 	/// </summary>
 	/// <param name="tau_alpha">    (  alpha) </param>
 	/// <param name="eta">    (  beta) </param>
-	void solve(Graph& g, int s, vector<int>& visited, vector<int>& choices, vector<vector<double>>& weights)
+	/// <param name="n_threads">  ,     </param>
+	void solve(Graph& g, int s, int* visited, int* choices, Matrix<double>& weights, int n_threads = 1)
 	{
 		_n_cities = g.n();
 		_solution.resize(_n_cities + 1);
@@ -57,7 +163,41 @@ public:
 			int from = _solution[i - 1];
 
 			//   
-			int to = next(visited, choices, weights[from]);
+			int to = n_threads > 1 ? next_parallel(visited, weights[from], n_threads) : next(visited, choices, weights[from]);
+
+			// : ... -> from -> to -> ...
+			_solution[i] = to; _len += g[from][to];
+			visited[to] = 1;
+		}
+
+		// : s -> ... -> t -> s
+		int t = _solution[_n_cities - 1];
+		_solution[_n_cities] = s; _len += g[t][s];
+	}
+
+	/// <summary>
+	///     (ACS):   
+	///  .    ,
+	///     :  
+	///        
+	/// </summary>
+	/// <param name="weights">    </param>
+	/// <param name="q0">    </param>
+	void solve(Graph& g, int s, int* visited, int* choices, Matrix<double>& weights, double q0)
+	{
+		_n_cities = g.n();
+		_solution.resize(_n_cities + 1);
+
+		// : s -> ...
+		_solution[0] = s; _len = 0;
+		visited[s] = 1;
+
+		for (int i = 1; i < _n_cities; ++i)
+		{
+			int from = _solution[i - 1];
+
+			//   
+			int to = next_acs(visited, choices, weights[from], q0);
 
 			// : ... -> from -> to -> ...
 			_solution[i] = to; _len += g[from][to];
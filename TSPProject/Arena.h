@@ -0,0 +1,314 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <new>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+/// <summary>
+///     (,  ):  i 
+///  data + i * stride,      64 
+/// </summary>
+/// <typeparam name="T">   </typeparam>
+template <class T>
+class Matrix
+{
+	T* _data = nullptr;
+	int _rows = 0, _cols = 0;
+	size_t _stride = 0;
+
+public:
+
+	Matrix() {}
+
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="data">   </param>
+	/// <param name="rows">   </param>
+	/// <param name="cols">   </param>
+	/// <param name="stride">  ( )    </param>
+	Matrix(T* data, int rows, int cols, size_t stride) : _data(data), _rows(rows), _cols(cols), _stride(stride) {}
+
+	/// <summary>
+	///    :    64 
+	/// </summary>
+	/// <param name="cols">   </param>
+	static size_t stride_for(int cols) { return ((size_t)cols * sizeof(T) + 63) / 64 * 64 / sizeof(T); }
+
+	/// <summary>
+	///    (    )
+	/// </summary>
+	/// <param name="rows">   </param>
+	/// <param name="cols">   </param>
+	static size_t bytes(int rows, int cols) { return (size_t)rows * stride_for(cols) * sizeof(T) + 64; }
+
+	int rows() const { return _rows; }
+	int cols() const { return _cols; }
+
+	/// <summary>
+	///   
+	/// </summary>
+	/// <param name="i">  </param>
+	/// <returns>     i </returns>
+	T* operator [] (int i) { return _data + i * _stride; }
+	const T* operator [] (int i) const { return _data + i * _stride; }
+};
+
+/// <summary>
+/// :         
+///  .     
+///   :   
+///    .   2   
+///     (  TLB 
+///     )
+/// </summary>
+class Arena
+{
+	/// <summary>
+	///   
+	/// </summary>
+	static const size_t huge_page = (size_t)2 << 20;
+
+	/// <summary>
+	///   
+	/// </summary>
+	static const size_t alignment = 64;
+
+	/// <summary>
+	///   :
+	/// <para> - None ( ) </para>
+	/// <para> - Pages ( : mmap / VirtualAlloc) </para>
+	/// <para> - Heap ( operator new) </para>
+	/// </summary>
+	enum class Source { None, Pages, Heap };
+
+	Source _source = Source::None;
+
+	/// <summary>
+	///     ( )   
+	/// </summary>
+	void* _map = nullptr;
+	size_t _map_size = 0;
+
+	/// <summary>
+	///   (),     
+	/// </summary>
+	char* _base = nullptr;
+	size_t _capacity = 0, _used = 0;
+
+	/// <summary>
+	///      
+	/// </summary>
+	bool _huge = false;
+
+	/// <summary>
+	///  
+	/// </summary>
+	void release()
+	{
+		if (_source == Source::Pages)
+		{
+#ifdef _WIN32
+			VirtualFree(_map, 0, MEM_RELEASE);
+#else
+			munmap(_map, _map_size);
+#endif
+		}
+		else if (_source == Source::Heap) ::operator delete(_map, align_val_t(alignment));
+
+		_source = Source::None;
+		_map = nullptr;
+		_base = nullptr;
+		_map_size = _capacity = _used = 0;
+		_huge = false;
+	}
+
+	/// <summary>
+	///  :   ,   
+	/// ( Linux -        ),  
+	/// </summary>
+	/// <param name="bytes">   </param>
+	void acquire(size_t bytes)
+	{
+		if (bytes >= huge_page)
+		{
+			bytes = (bytes + huge_page - 1) / huge_page * huge_page;
+
+#ifdef _WIN32
+			//   SeLockMemoryPrivilege
+			size_t large = GetLargePageMinimum();
+
+			if (large != 0)
+			{
+				size_t size = (bytes + large - 1) / large * large;
+				void* p = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+
+				if (p != nullptr)
+				{
+					take(Source::Pages, p, size, (char*)p, size, true);
+					return;
+				}
+			}
+
+			void* p = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+			if (p != nullptr)
+			{
+				take(Source::Pages, p, bytes, (char*)p, bytes, false);
+				return;
+			}
+#else
+#ifdef MAP_HUGETLB
+			//    (    )
+			void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+			if (p != MAP_FAILED)
+			{
+				take(Source::Pages, p, bytes, (char*)p, bytes, true);
+				return;
+			}
+#endif
+			//   :     2 
+			size_t size = bytes + huge_page;
+			void* q = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if (q != MAP_FAILED)
+			{
+				char* base = (char*)(((uintptr_t)q + huge_page - 1) & ~(uintptr_t)(huge_page - 1));
+				bool huge = false;
+
+#ifdef MADV_HUGEPAGE
+				huge = madvise(base, bytes, MADV_HUGEPAGE) == 0;
+#endif
+				take(Source::Pages, q, size, base, bytes, huge);
+				return;
+			}
+#endif
+		}
+
+		void* p = ::operator new(bytes, align_val_t(alignment));
+		take(Source::Heap, p, bytes, (char*)p, bytes, false);
+	}
+
+	/// <summary>
+	///   
+	/// </summary>
+	void take(Source source, void* map, size_t map_size, char* base, size_t capacity, bool huge)
+	{
+		_source = source;
+		_map = map;
+		_map_size = map_size;
+		_base = base;
+		_capacity = capacity;
+		_used = 0;
+		_huge = huge;
+	}
+
+public:
+
+	Arena() {}
+
+	~Arena() { release(); }
+
+	Arena(const Arena&) = delete;
+	Arena& operator = (const Arena&) = delete;
+
+	Arena(Arena&& other) noexcept { *this = move(other); }
+
+	Arena& operator = (Arena&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			take(other._source, other._map, other._map_size, other._base, other._capacity, other._huge);
+			_used = other._used;
+
+			other._source = Source::None;
+			other.release();
+		}
+
+		return *this;
+	}
+
+	/// <summary>
+	///     bytes:   ,
+	///   .      .
+	///      (,   
+	///    ):     , 
+	///        
+	/// </summary>
+	/// <param name="bytes">   </param>
+	void reserve(size_t bytes)
+	{
+		if (bytes > _capacity)
+		{
+			release();
+			acquire(bytes);
+		}
+
+		_used = 0;
+	}
+
+	/// <summary>
+	///    count  ( :
+	///      NUMA ,  
+	///  ;       , . reserve)
+	/// </summary>
+	/// <typeparam name="T">   ( ) </typeparam>
+	/// <param name="count">   </param>
+	template <class T>
+	T* allocate(size_t count)
+	{
+		size_t offset = (_used + alignment - 1) / alignment * alignment;
+
+		assert(offset + count * sizeof(T) <= _capacity);
+
+		_used = offset + count * sizeof(T);
+
+		return (T*)(_base + offset);
+	}
+
+	/// <summary>
+	///   (   64 )
+	/// </summary>
+	/// <typeparam name="T">   ( ) </typeparam>
+	/// <param name="rows">   </param>
+	/// <param name="cols">   </param>
+	template <class T>
+	Matrix<T> matrix(int rows, int cols)
+	{
+		size_t stride = Matrix<T>::stride_for(cols);
+
+		return Matrix<T>(allocate<T>((size_t)rows * stride), rows, cols, stride);
+	}
+
+	/// <summary>
+	///     
+	/// </summary>
+	bool empty() const { return _base == nullptr; }
+
+	/// <summary>
+	///      
+	/// </summary>
+	bool huge_pages() const { return _huge; }
+
+	/// <summary>
+	///  
+	/// </summary>
+	size_t capacity() const { return _capacity; }
+};
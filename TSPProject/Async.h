@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "Graph.h"
+
+/// <summary>
+///   .     :
+///        cancel,
+///   cancelled   ()
+/// </summary>
+class CancellationToken
+{
+	shared_ptr<atomic<bool>> _flag;
+
+public:
+
+	/// <summary>
+	///   (  )   
+	/// </summary>
+	CancellationToken() : _flag(make_shared<atomic<bool>>(false)) {}
+
+	/// <summary>
+	///   (  )
+	/// </summary>
+	static CancellationToken create() { return CancellationToken(); }
+
+	/// <summary>
+	///  
+	/// </summary>
+	void cancel()
+	{
+		_flag->store(true, memory_order_relaxed);
+	}
+
+	/// <summary>
+	///   
+	/// </summary>
+	bool cancelled() const
+	{
+		return _flag->load(memory_order_relaxed);
+	}
+};
+
+/// <summary>
+///    :
+/// <para> - iter ( ) </para>
+/// <para> - len (   ) </para>
+/// <para> - time (     ) </para>
+/// </summary>
+struct Progress
+{
+	int iter;
+	int len;
+	double time;
+};
+
+/// <summary>
+///     .    
+/// (  ),    
+/// </summary>
+using ProgressCallback = function<void(const Progress&)>;
+
+/// <summary>
+///     .     
+///   ;     future
+/// </summary>
+/// <typeparam name="Solver">    solve(Graph&) </typeparam>
+/// <param name="solver">  </param>
+/// <param name="g">  </param>
+/// <returns> future,     </returns>
+template <class Solver>
+future<void> solve_async(Solver& solver, Graph& g)
+{
+	return async(launch::async, [&solver, &g] { solver.solve(g); });
+}
@@ -0,0 +1,323 @@
+#pragma once
+#include <stdexcept>
+#include <tuple>
+
+#include "ACOSolver.h"
+
+/// <summary>
+///     "" :   ,
+///    ,       
+/// (   -    )    ,
+/// .     ,   
+///        :   
+///    .       
+/// </summary>
+class BackboneSolver : public TSPSolver
+{
+	/// <summary>
+	///    (max_iter -    )
+	/// </summary>
+	ACOConfig _aco_config;
+
+	/// <summary>
+	///   
+	/// </summary>
+	int _max_stages;
+
+	/// <summary>
+	///   :  ,  
+	///         dominance * tau 
+	/// </summary>
+	double _dominance;
+
+	/// <summary>
+	///    ,    
+	/// </summary>
+	double _max_fix;
+
+	/// <summary>
+	///   ,     
+	/// </summary>
+	vector<vector<int>> _paths;
+
+	/// <summary>
+	///     ( )
+	/// </summary>
+	int _fixed_len;
+
+	/// <summary>
+	///      
+	/// </summary>
+	vector<int> _stage_sizes;
+
+	/// <summary>
+	///    :    -
+	///         
+	/// </summary>
+	/// <param name="g">   </param>
+	/// <returns>   </returns>
+	Graph contract(Graph& g)
+	{
+		int m = (int)_paths.size();
+		vector<int> data((size_t)m * m, 0);
+
+		for (int s = 0; s < m; ++s)
+			for (int t = 0; t < m; ++t)
+				if (s != t) data[(size_t)s * m + t] = g[_paths[s].back()][_paths[t].front()];
+
+		return Graph(move(data), m);
+	}
+
+	/// <summary>
+	///        :
+	///   (s, t) -      ,
+	///   s,  ,    t
+	/// </summary>
+	/// <param name="tau">     </param>
+	/// <param name="old_paths">    </param>
+	/// <returns>      </returns>
+	vector<vector<double>> carry_tau(const vector<vector<double>>& tau, const vector<vector<int>>& old_paths)
+	{
+		vector<int> head(_n_cities, -1), tail(_n_cities, -1);
+
+		for (int s = 0; s < (int)old_paths.size(); ++s)
+		{
+			head[old_paths[s].front()] = s;
+			tail[old_paths[s].back()] = s;
+		}
+
+		int m = (int)_paths.size();
+		vector<vector<double>> result(m, vector<double>(m, 0));
+
+		for (int s = 0; s < m; ++s)
+			for (int t = 0; t < m; ++t)
+				if (s != t) result[s][t] = tau[tail[_paths[s].back()]][head[_paths[t].front()]];
+
+		return result;
+	}
+
+	/// <summary>
+	///        
+	/// </summary>
+	/// <param name="tour">    </param>
+	/// <returns>    </returns>
+	vector<int> expand(const vector<int>& tour)
+	{
+		vector<int> result;
+		result.reserve(_n_cities + 1);
+
+		for (int j = 0; j + 1 < (int)tour.size(); ++j)
+			result.insert(result.end(), _paths[tour[j]].begin(), _paths[tour[j]].end());
+
+		result.push_back(result[0]);
+
+		return result;
+	}
+
+	/// <summary>
+	///        
+	/// (     )
+	/// </summary>
+	/// <param name="tour">    </param>
+	/// <returns>    </returns>
+	vector<int> reduce(const vector<int>& tour)
+	{
+		vector<int> head(_n_cities, -1);
+
+		for (int s = 0; s < (int)_paths.size(); ++s)
+			head[_paths[s].front()] = s;
+
+		vector<int> result;
+		result.reserve(_paths.size() + 1);
+
+		for (int j = 0; j < _n_cities; ++j)
+			if (head[tour[j]] >= 0) result.push_back(head[tour[j]]);
+
+		result.push_back(result[0]);
+
+		return result;
+	}
+
+	/// <summary>
+	///        
+	/// </summary>
+	/// <param name="g">   </param>
+	/// <param name="tour">    (   ) </param>
+	/// <param name="tau">    </param>
+	/// <param name="prev_succ">        ( -  ) </param>
+	/// <returns>    </returns>
+	int fix(Graph& g, const vector<int>& tour, const vector<vector<double>>& tau, const vector<int>& prev_succ)
+	{
+		int m = (int)_paths.size();
+
+		// :      
+		vector<tuple<double, int, int>> candidates;
+
+		for (int j = 0; j < m; ++j)
+		{
+			int s = tour[j], t = tour[j + 1];
+
+			//         ,   
+			if (tau[s][t] <= 0) continue;
+			if (!prev_succ.empty() && prev_succ[_paths[s].back()] != _paths[t].front()) continue;
+
+			double rival = 0;
+
+			for (int k = 0; k < m; ++k)
+				if (k != s && k != t)
+					rival = max(rival, max(tau[s][k], tau[k][t]));
+
+			if (rival < _dominance * tau[s][t])
+				candidates.emplace_back(rival / tau[s][t], g[_paths[s].back()][_paths[t].front()], j);
+		}
+
+		//      max_fix  : 
+		//    ,   -  .
+		//        
+		sort(candidates.begin(), candidates.end());
+		candidates.resize(max(0, min({ (int)candidates.size(), (int)(_max_fix * m), m - 3 })));
+
+		vector<char> fixed(m, 0);
+		int n_fixed = (int)candidates.size();
+
+		for (auto& c : candidates)
+			fixed[get<2>(c)] = 1;
+
+		if (n_fixed == 0) return 0;
+
+		//   ,      
+		// (max_fix < 1,      )
+		int first = 0;
+
+		while (fixed[(first + m - 1) % m]) ++first;
+
+		vector<vector<int>> paths;
+
+		for (int i = 0; i < m; ++i)
+		{
+			int j = (first + i) % m;
+			vector<int>& path = _paths[tour[j]];
+
+			if (i == 0 || !fixed[(j + m - 1) % m]) paths.emplace_back();
+			else _fixed_len += g[paths.back().back()][path.front()];
+
+			paths.back().insert(paths.back().end(), path.begin(), path.end());
+		}
+
+		_paths = move(paths);
+
+		return n_fixed;
+	}
+
+public:
+
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="aco_config">    (max_iter -  ) </param>
+	/// <param name="max_stages">    </param>
+	/// <param name="dominance">      </param>
+	/// <param name="max_fix">    ,    </param>
+	/// <exception cref="invalid_argument"> max_stages &lt; 1, dominance  (0, 1]  max_fix  (0, 1) </exception>
+	BackboneSolver(const ACOConfig& aco_config, int max_stages = 5, double dominance = 0.5, double max_fix = 0.5)
+		: _aco_config(aco_config), _max_stages(max_stages), _dominance(dominance), _max_fix(max_fix), _fixed_len(0)
+	{
+		if (max_stages < 1) throw invalid_argument("backbone: max_stages must be positive");
+		if (!(dominance > 0 && dominance <= 1)) throw invalid_argument("backbone: dominance must be in (0, 1]");
+		if (!(max_fix > 0 && max_fix < 1)) throw invalid_argument("backbone: max_fix must be in (0, 1)");
+	}
+
+	/// <summary>
+	///  
+	/// </summary>
+	/// <param name="g">  </param>
+	void solve(Graph& g)
+	{
+		_n_cities = g.n();
+		_fixed_len = 0;
+		_stage_sizes.clear();
+		_paths.assign(_n_cities, {});
+
+		for (int i = 0; i < _n_cities; ++i)
+			_paths[i] = { i };
+
+		Graph sub;
+		vector<int> prev_succ, init_sol;
+		vector<vector<double>> init_tau;
+
+		for (int stage = 0; stage < _max_stages; ++stage)
+		{
+			int m = (int)_paths.size();
+			bool reduced = m < _n_cities;
+
+			_stage_sizes.push_back(m);
+
+			ACOConfig config = _aco_config;
+
+			// ,       , 
+			//   ;       
+			if (reduced)
+			{
+				config.tau0 = 5.0 / max(1, _len - _fixed_len);
+				config.lower_bound = max(0, _aco_config.lower_bound - _fixed_len);
+				config.checkpoint_interval = 0;
+
+				// a    ,  MMAS  a < 1
+				config.a = min(0.99, _aco_config.a * _n_cities / m);
+
+				//    , 
+				//  (ASRank)  ,  
+				config.n_ants = min(config.n_ants, m);
+				config.k = min(config.k, config.n_ants);
+
+				if (config.type == ACOType::ASRank) config.w = min(config.w, config.n_ants + 1);
+			}
+
+			ACOSolver solver(config);
+
+			if (stage == 0) solver.solve(g);
+			else solver.solve(reduced ? sub : g, init_sol, init_tau);
+
+			_solution = expand(solver.solution());
+			_len = solver.len() + _fixed_len;
+
+			if (stage + 1 == _max_stages || m <= 3) break;
+
+			vector<int> succ(_n_cities);
+
+			for (int j = 0; j < _n_cities; ++j)
+				succ[_solution[j]] = _solution[j + 1];
+
+			vector<vector<int>> old_paths = _paths;
+			init_tau = solver.tau();
+
+			//        
+			if (fix(g, solver.solution(), init_tau, prev_succ) > 0)
+			{
+				sub = contract(g);
+				init_tau = carry_tau(init_tau, old_paths);
+			}
+
+			prev_succ = move(succ);
+			init_sol = reduce(_solution);
+		}
+	}
+
+	/// <summary>
+	///      
+	/// </summary>
+	vector<int> stage_sizes() { return _stage_sizes; }
+
+	/// <summary>
+	///    
+	/// </summary>
+	void print()
+	{
+		cout << "BackboneSolver ( ): ";
+
+		for (int i = 0; i < _n_cities; ++i)
+			cout << _solution[i] << " - ";
+
+		cout << _solution.back() << ",   = " << _len << "\n";
+	}
+};
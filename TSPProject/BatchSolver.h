@@ -0,0 +1,236 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <exception>
+
+#include "ACOSolver.h"
+
+/// <summary>
+///      
+/// </summary>
+struct BatchResult
+{
+	/// <summary>
+	///   ( submit)
+	/// </summary>
+	int id;
+
+	/// <summary>
+	///     
+	/// </summary>
+	vector<int> solution;
+	int len;
+
+	/// <summary>
+	///   ( )
+	/// </summary>
+	double time;
+
+	/// <summary>
+	///    (,   )
+	/// </summary>
+	string error;
+};
+
+/// <summary>
+///      :
+///       ,
+///     ACOSolver,   
+///    .     
+/// </summary>
+class BatchSolver
+{
+	/// <summary>
+	///     
+	/// (, tau0     )
+	/// </summary>
+	function<ACOConfig(Graph&)> _configure;
+
+	/// <summary>
+	///  
+	/// </summary>
+	vector<thread> _workers;
+
+	/// <summary>
+	///  :    
+	/// </summary>
+	deque<pair<int, Graph>> _jobs;
+
+	/// <summary>
+	///   
+	/// </summary>
+	deque<BatchResult> _results;
+
+	/// <summary>
+	///  :
+	/// <para> - jobs_cv (    ) </para>
+	/// <para> - results_cv ( ) </para>
+	/// </summary>
+	mutex _mutex;
+	condition_variable _jobs_cv, _results_cv;
+
+	/// <summary>
+	///  :
+	/// <para> - submitted ( ) </para>
+	/// <para> - returned (  ) </para>
+	/// </summary>
+	int _submitted = 0, _returned = 0;
+
+	/// <summary>
+	///   
+	/// </summary>
+	bool _stop = false;
+
+	/// <summary>
+	///  :    ,    
+	/// </summary>
+	void work()
+	{
+		//  :     
+		unique_ptr<ACOSolver> solver;
+
+		while (true)
+		{
+			pair<int, Graph> job;
+
+			{
+				unique_lock<mutex> lock(_mutex);
+				_jobs_cv.wait(lock, [&] { return _stop || !_jobs.empty(); });
+
+				if (_jobs.empty()) return;
+
+				job = move(_jobs.front());
+				_jobs.pop_front();
+			}
+
+			Graph& g = job.second;
+			BatchResult result = { job.first, {}, INF, 0, "" };
+
+			system_clock::time_point start = system_clock::now();
+
+			try
+			{
+				ACOConfig config = _configure(g);
+
+				if (solver) solver->configure(config);
+				else solver = make_unique<ACOSolver>(config);
+
+				solver->solve(g);
+
+				result.solution = solver->solution();
+				result.len = solver->len();
+			}
+			catch (exception& e)
+			{
+				result.error = e.what();
+			}
+
+			duration <double> delta = system_clock::now() - start;
+			result.time = delta.count();
+
+			{
+				lock_guard<mutex> lock(_mutex);
+				_results.push_back(move(result));
+			}
+
+			_results_cv.notify_one();
+		}
+	}
+
+public:
+
+	/// <summary>
+	/// :   
+	/// </summary>
+	/// <param name="n_workers">    </param>
+	/// <param name="configure">     
+	/// (n_jobs    1:  -  ) </param>
+	BatchSolver(int n_workers, function<ACOConfig(Graph&)> configure) : _configure(configure)
+	{
+		for (int i = 0; i < n_workers; ++i)
+			_workers.emplace_back(&BatchSolver::work, this);
+	}
+
+	/// <summary>
+	/// :   
+	/// </summary>
+	/// <param name="n_workers">    </param>
+	/// <param name="config">   (   ) </param>
+	BatchSolver(int n_workers, const ACOConfig& config)
+		: BatchSolver(n_workers, [config](Graph&) { return config; }) {}
+
+	BatchSolver(const BatchSolver&) = delete;
+	BatchSolver& operator = (const BatchSolver&) = delete;
+
+	/// <summary>
+	/// :   ,
+	///  - 
+	/// </summary>
+	~BatchSolver()
+	{
+		{
+			lock_guard<mutex> lock(_mutex);
+			_jobs.clear();
+			_stop = true;
+		}
+
+		_jobs_cv.notify_all();
+
+		for (thread& worker : _workers)
+			worker.join();
+	}
+
+	/// <summary>
+	///    
+	/// </summary>
+	/// <param name="g">  (  ) </param>
+	/// <returns>   </returns>
+	int submit(Graph g)
+	{
+		int id;
+
+		{
+			lock_guard<mutex> lock(_mutex);
+
+			id = _submitted++;
+			_jobs.emplace_back(id, move(g));
+		}
+
+		_jobs_cv.notify_one();
+		return id;
+	}
+
+	/// <summary>
+	///    (  ,
+	///      ). ,   
+	///   ,     
+	/// </summary>
+	/// <param name="result">  </param>
+	/// <returns> false,       </returns>
+	bool next_result(BatchResult& result)
+	{
+		unique_lock<mutex> lock(_mutex);
+
+		if (_returned == _submitted) return false;
+
+		_results_cv.wait(lock, [&] { return !_results.empty(); });
+
+		result = move(_results.front());
+		_results.pop_front();
+		++_returned;
+
+		return true;
+	}
+
+	/// <summary>
+	///  ,     
+	/// </summary>
+	int pending()
+	{
+		lock_guard<mutex> lock(_mutex);
+		return _submitted - _returned;
+	}
+};
@@ -0,0 +1,225 @@
+#pragma once
+#include "NNSolver.h"
+#include "ACOSolver.h"
+
+/// <summary>
+///      (  POPMUSIC):
+///          ,
+///     (  ) 
+/// k-opt    ,   
+///     .    
+///  ,    
+/// </summary>
+class DecompositionSolver : public TSPSolver
+{
+	/// <summary>
+	///  :
+	/// <para> - window (   ) </para>
+	/// <para> - max_passes (    ) </para>
+	/// <para> - n_jobs (  ) </para>
+	/// </summary>
+	int _window, _max_passes, _n_jobs;
+
+	/// <summary>
+	///    (None -  )
+	/// </summary>
+	LocalSearchType _local_search_type;
+
+	/// <summary>
+	///     
+	/// (tau0  n_jobs    )
+	/// </summary>
+	ACOConfig _aco_config;
+
+	/// <summary>
+	///    
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="cities">      ( ) </param>
+	/// <returns>      </returns>
+	int improve_window(Graph& g, vector<int>& cities)
+	{
+		int w = cities.size();
+
+		//   : cities[0] -> ... -> cities[w - 1]
+		int path_len = 0;
+
+		for (int i = 0; i + 1 < w; ++i)
+			path_len += g[cities[i]][cities[i + 1]];
+
+		// :   (w - 1) -> 0  1,  
+		//  (w - 1)   0 -     
+		int big = path_len + 2;
+		vector<int> data((size_t)w * w);
+
+		for (int a = 0; a < w; ++a)
+			for (int b = 0; b < w; ++b)
+				data[(size_t)a * w + b] = (a == w - 1 && b == 0) ? 1 : ((a == w - 1 || b == 0) && a != b) ? big : g[cities[a]][cities[b]];
+
+		Graph sub(move(data), w);
+
+		vector<int> tour(w + 1);
+
+		for (int i = 0; i < w; ++i)
+			tour[i] = i;
+
+		tour[w] = 0;
+
+		int len = path_len + 1;
+
+		if (_local_search_type != LocalSearchType::None)
+		{
+			KOptSolver solver;
+			solver.solve(sub, _local_search_type, tour, len);
+
+			tour = solver.solution();
+			len = solver.len();
+		}
+		else
+		{
+			ACOConfig config = _aco_config;
+			config.tau0 = 5.0 / len;
+			config.n_jobs = 1;
+
+			//        
+			config.reorder = ReorderType::None;
+
+			//    :     
+			config.n_ants = min(config.n_ants, w);
+			config.k = min(config.k, config.n_ants);
+
+			ACOSolver solver(config);
+			solver.solve(sub);
+
+			if (solver.len() >= len) return 0;
+
+			tour = solver.solution();
+			len = solver.len();
+		}
+
+		if (len - 1 >= path_len) return 0;
+
+		//    ,     0
+		// ( 0   w - 1)
+		tour.pop_back();
+		rotate(tour.begin(), find(tour.begin(), tour.end(), 0), tour.end());
+
+		if (tour.back() != w - 1) return 0;
+
+		vector<int> improved(w);
+
+		for (int i = 0; i < w; ++i)
+			improved[i] = cities[tour[i]];
+
+		cities = improved;
+
+		return path_len - (len - 1);
+	}
+
+public:
+
+	/// <summary>
+	/// :   k-opt 
+	/// </summary>
+	/// <param name="window">     </param>
+	/// <param name="max_passes">      </param>
+	/// <param name="n_jobs">    </param>
+	/// <param name="local_search_type">  k-opt  </param>
+	DecompositionSolver(int window, int max_passes, int n_jobs, LocalSearchType local_search_type)
+		: _window(window), _max_passes(max_passes), _n_jobs(n_jobs), _local_search_type(local_search_type)
+	{
+		assert(local_search_type != LocalSearchType::None);
+	}
+
+	/// <summary>
+	/// :    
+	/// </summary>
+	/// <param name="window">     </param>
+	/// <param name="max_passes">      </param>
+	/// <param name="n_jobs">    </param>
+	/// <param name="aco_config">    </param>
+	DecompositionSolver(int window, int max_passes, int n_jobs, const ACOConfig& aco_config)
+		: _window(window), _max_passes(max_passes), _n_jobs(n_jobs),
+		_local_search_type(LocalSearchType::None), _aco_config(aco_config) {}
+
+	/// <summary>
+	///  ,     
+	/// </summary>
+	/// <param name="g">  </param>
+	void solve(Graph& g)
+	{
+		NNSolver nn;
+		nn.solve(g);
+
+		solve(g, nn.solution(), nn.len());
+	}
+
+	/// <summary>
+	///  ,    
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="init_sol">   </param>
+	/// <param name="init_len">    </param>
+	void solve(Graph& g, vector<int> init_sol, int init_len)
+	{
+		_solution = init_sol;
+		_len = init_len;
+		_n_cities = g.n();
+
+		if (_n_cities < 4) return;
+
+		int w = min(_window, _n_cities);
+		int n_windows = _n_cities / w;
+
+		//     
+		int idle = 0;
+
+		for (int pass = 0; pass < _max_passes && idle < 2; ++pass)
+		{
+			//  :    
+			uniform_int_distribution <int> interval_int(0, _n_cities - 1);
+			int offset = interval_int(gen);
+
+			int gain = 0;
+
+			#pragma omp parallel for num_threads(_n_jobs) schedule(dynamic) reduction(+ : gain)
+			for (int t = 0; t < n_windows; ++t)
+			{
+				int start = offset + t * w;
+				vector<int> cities(w);
+
+				for (int i = 0; i < w; ++i)
+					cities[i] = _solution[(start + i) % _n_cities];
+
+				int delta = improve_window(g, cities);
+
+				//     
+				if (delta > 0)
+				{
+					for (int i = 0; i < w; ++i)
+						_solution[(start + i) % _n_cities] = cities[i];
+
+					gain += delta;
+				}
+			}
+
+			_solution[_n_cities] = _solution[0];
+			_len -= gain;
+
+			idle = gain > 0 ? 0 : idle + 1;
+		}
+	}
+
+	/// <summary>
+	///    
+	/// </summary>
+	void print()
+	{
+		cout << "DecompositionSolver ( ): ";
+
+		for (int i = 0; i < _n_cities; ++i)
+			cout << _solution[i] << " - ";
+
+		cout << _solution.back() << ",   = " << _len << "\n";
+	}
+};
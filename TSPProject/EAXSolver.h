@@ -0,0 +1,678 @@
+#pragma once
+#include <stdexcept>
+
+#include "NNSolver.h"
+#include "KOptSolver.h"
+
+/// <summary>
+///       (EAX)
+///   .     
+/// .   (A, B)   A  
+///  AB-  B;     
+///    .    
+///   (KOptSolver)   A,   .
+///   :    
+///     ( )
+/// </summary>
+class EAXSolver : public TSPSolver
+{
+	/// <summary>
+	///  :
+	/// <para> - pop_size ( ) </para>
+	/// <para> - n_children (   ) </para>
+	/// <para> - max_gen (  ) </para>
+	/// <para> - stall (       ) </para>
+	/// <para> - n_jobs (  ) </para>
+	/// </summary>
+	int _pop_size, _n_children, _max_gen, _stall, _n_jobs;
+
+	/// <summary>
+	///    (None -  )
+	/// </summary>
+	LocalSearchType _local_search_type;
+
+	/// <summary>
+	///   
+	/// </summary>
+	int _generations;
+
+	/// <summary>
+	///  (   ): _succ[p][v] - ,
+	///   v   p,   
+	/// </summary>
+	vector<vector<int>> _succ, _next_succ;
+	vector<int> _lens, _next_lens;
+
+	/// <summary>
+	///    (    )
+	/// </summary>
+	Neighbors _nn;
+
+	/// <summary>
+	///   :
+	/// <para> - pred_a, pred_b (   ) </para>
+	/// <para> - pos_a (    A) </para>
+	/// <para> - mark (    AB-) </para>
+	/// <para> - cycles, cycle_start ( AB-    ) </para>
+	/// <para> - succ, pred ( ;    A) </para>
+	/// <para> - seg_end, seg_pos, seg_comp (  A  
+	/// :  ,    A   ) </para>
+	/// <para> - in_u, merge (     ) </para>
+	/// <para> - comp_size, comp_start, comp_parent ( ; 
+	///    ,    ) </para>
+	/// <para> - members (  ) </para>
+	/// <para> - changed, stamp (,      ) </para>
+	/// <para> - best (  :   (v, succ v)) </para>
+	/// </summary>
+	struct Workspace
+	{
+		vector<int> pred_a, pred_b, pos_a, mark, cycles, cycle_start;
+		vector<int> succ, pred, seg_end, seg_pos, seg_comp, comp_size, comp_start, comp_parent, members, changed, stamp, in_u;
+		vector<pair<int, int>> best;
+		int child = 0, merge = 0;
+	};
+
+	vector<Workspace> _work;
+
+	/// <summary>
+	///    : _freq[u] -  (v,     u -> v).
+	///    
+	/// </summary>
+	vector<vector<pair<int, int>>> _freq;
+
+	/// <summary>
+	///      u -> v
+	/// </summary>
+	int freq(int u, int v)
+	{
+		for (auto& [x, count] : _freq[u])
+			if (x == v) return count;
+
+		return 0;
+	}
+
+	/// <summary>
+	///    u -> v  delta
+	/// </summary>
+	void add_freq(int u, int v, int delta)
+	{
+		for (auto& [x, count] : _freq[u])
+			if (x == v)
+			{
+				count += delta;
+				return;
+			}
+
+		_freq[u].push_back({ v, delta });
+	}
+
+	/// <summary>
+	///     f   
+	/// </summary>
+	double entropy(int f)
+	{
+		if (f <= 0) return 0;
+
+		double p = (double)f / _pop_size;
+
+		return -p * log(p);
+	}
+
+	/// <summary>
+	///  ,       
+	/// </summary>
+	static void touch(Workspace& w, int v)
+	{
+		if (w.stamp[v] == w.child) return;
+
+		w.stamp[v] = w.child;
+		w.changed.push_back(v);
+	}
+
+	/// <summary>
+	///  (  )   
+	/// </summary>
+	static void to_succ(const vector<int>& tour, vector<int>& succ)
+	{
+		int n = tour.size() - 1;
+		succ.resize(n);
+
+		for (int i = 0; i < n; ++i)
+			succ[tour[i]] = tour[i + 1];
+	}
+
+	/// <summary>
+	///       0 (  )
+	/// </summary>
+	static vector<int> to_tour(const vector<int>& succ)
+	{
+		int n = succ.size();
+		vector<int> tour(n + 1);
+
+		for (int i = 0, v = 0; i <= n; ++i, v = succ[v])
+			tour[i] = v;
+
+		return tour;
+	}
+
+	/// <summary>
+	///   A,   x (. label_subtours)
+	/// </summary>
+	static int segment_of(Workspace& w, int x)
+	{
+		int j = lower_bound(w.seg_pos.begin(), w.seg_pos.end(), w.pos_a[x]) - w.seg_pos.begin();
+
+		return j == (int)w.seg_pos.size() ? 0 : j;
+	}
+
+	/// <summary>
+	///  ,   x
+	/// </summary>
+	static int comp_of(Workspace& w, int x)
+	{
+		int c = w.seg_comp[segment_of(w, x)];
+
+		while (w.comp_parent[c] != c)
+			c = w.comp_parent[c] = w.comp_parent[w.comp_parent[c]];
+
+		return c;
+	}
+
+	/// <summary>
+	///    .    A 
+	///    ,   A  
+	///  ,     :  
+	///   AB-,     
+	/// </summary>
+	/// <returns>   </returns>
+	int label_subtours(Workspace& w, const vector<int>& succ_a)
+	{
+		int n = _n_cities, n_comps = 0;
+
+		//  j -    seg_end[j - 1]  seg_end[j]   A
+		w.seg_end = w.changed;
+		sort(w.seg_end.begin(), w.seg_end.end(), [&](int u, int v) { return w.pos_a[u] < w.pos_a[v]; });
+
+		int k = w.seg_end.size();
+
+		w.seg_pos.resize(k);
+
+		for (int j = 0; j < k; ++j)
+			w.seg_pos[j] = w.pos_a[w.seg_end[j]];
+
+		w.seg_comp.assign(k, -1);
+		w.comp_size.clear();
+		w.comp_start.clear();
+		w.comp_parent.clear();
+
+		for (int s = 0; s < k; ++s)
+		{
+			if (w.seg_comp[s] != -1) continue;
+
+			int size = 0;
+
+			for (int j = s; w.seg_comp[j] == -1; j = segment_of(w, w.succ[w.seg_end[j]]))
+			{
+				w.seg_comp[j] = n_comps;
+				size += k == 1 ? n : (w.seg_pos[j] - w.seg_pos[(j + k - 1) % k] + n) % n;
+			}
+
+			w.comp_size.push_back(size);
+			w.comp_start.push_back(succ_a[w.seg_end[(s + k - 1) % k]]);
+			w.comp_parent.push_back(n_comps);
+			++n_comps;
+		}
+
+		return n_comps;
+	}
+
+	/// <summary>
+	///   :    U 
+	///     (v, succ v), (u, x)  (v, x), (u, succ v),
+	///  v  U, x -   v  U, u = pred x.
+	///     U   U,   
+	/// </summary>
+	/// <returns>   </returns>
+	int merge_subtours(Graph& g, Workspace& w, int n_comps)
+	{
+		int delta_sum = 0;
+
+		for (; n_comps > 1; --n_comps)
+		{
+			int cu = -1;
+
+			for (int c = 0; c < (int)w.comp_size.size(); ++c)
+				if (w.comp_size[c] > 0 && (cu == -1 || w.comp_size[c] < w.comp_size[cu])) cu = c;
+
+			w.members.clear();
+			++w.merge;
+
+			for (int v = w.comp_start[cu]; ; )
+			{
+				w.members.push_back(v);
+				w.in_u[v] = w.merge;
+				v = w.succ[v];
+
+				if (v == w.comp_start[cu]) break;
+			}
+
+			int best_delta = INF, best_v = -1, best_x = -1;
+
+			for (int v : w.members)
+				for (int x : _nn.out[v])
+				{
+					if (w.in_u[x] == w.merge) continue;
+
+					int u = w.pred[x];
+					int delta = g[v][x] + g[u][w.succ[v]] - g[v][w.succ[v]] - g[u][x];
+
+					if (delta < best_delta) { best_delta = delta; best_v = v; best_x = x; }
+				}
+
+			if (best_v == -1)
+				for (int x = 0; x < _n_cities; ++x)
+				{
+					if (w.in_u[x] == w.merge) continue;
+
+					int u = w.pred[x];
+
+					for (int v : w.members)
+					{
+						int delta = g[v][x] + g[u][w.succ[v]] - g[v][w.succ[v]] - g[u][x];
+
+						if (delta < best_delta) { best_delta = delta; best_v = v; best_x = x; }
+					}
+				}
+
+			int v = best_v, x = best_x, u = w.pred[x], y = w.succ[v];
+			int cw = comp_of(w, x);
+
+			w.succ[v] = x; w.pred[x] = v;
+			w.succ[u] = y; w.pred[y] = u;
+
+			touch(w, v);
+			touch(w, u);
+
+			w.comp_parent[cu] = cw;
+
+			w.comp_size[cw] += w.comp_size[cu];
+			w.comp_size[cu] = 0;
+
+			delta_sum += best_delta;
+		}
+
+		return delta_sum;
+	}
+
+	/// <summary>
+	///    A     
+	///    A,      (. crossover)
+	/// </summary>
+	/// <param name="dl">    A ( 0) </param>
+	void evaluate(Workspace& w, const vector<int>& succ_a, double dl, double& best_eval, int& best_len, int len)
+	{
+		//  :  A ,   
+		double dh = 0;
+
+		for (int v : w.changed)
+		{
+			if (w.succ[v] == succ_a[v]) continue;
+
+			int f_out = freq(v, succ_a[v]), f_in = freq(v, w.succ[v]);
+
+			dh += entropy(f_out - 1) - entropy(f_out) + entropy(f_in + 1) - entropy(f_in);
+		}
+
+		double eval = dh < 0 ? dl / dh : -dl / 1e-9;
+
+		if (eval <= best_eval) return;
+
+		best_eval = eval;
+		best_len = len;
+		w.best.clear();
+
+		for (int v : w.changed)
+			if (w.succ[v] != succ_a[v]) w.best.push_back({ v, w.succ[v] });
+	}
+
+	/// <summary>
+	///   a  b  :  n_children ,
+	///  -   AB-.    AB-
+	/// :   u (succ_a u != succ_b u)    A
+	///  succ_a u,    B  pred_b(succ_a u).
+	///    A  ,    
+	///         ( 
+	///   -    ):   
+	///     
+	/// </summary>
+	/// <param name="w">    </param>
+	/// <returns>    (INF,      A);    A -  w.best </returns>
+	int crossover(Graph& g, Workspace& w, int a, int b)
+	{
+		int n = _n_cities;
+		vector<int>& succ_a = _succ[a];
+		vector<int>& succ_b = _succ[b];
+
+		w.pred_b.resize(n);
+
+		for (int v = 0; v < n; ++v)
+			w.pred_b[succ_b[v]] = v;
+
+		// AB-
+		w.mark.assign(n, 0);
+		w.cycles.clear();
+		w.cycle_start.clear();
+
+		for (int s = 0; s < n; ++s)
+		{
+			if (w.mark[s] || succ_a[s] == succ_b[s]) continue;
+
+			w.cycle_start.push_back(w.cycles.size());
+
+			for (int u = s; !w.mark[u]; u = w.pred_b[succ_a[u]])
+			{
+				w.mark[u] = 1;
+				w.cycles.push_back(u);
+			}
+		}
+
+		int n_cycles = w.cycle_start.size();
+		w.cycle_start.push_back(w.cycles.size());
+
+		if (n_cycles == 0) return INF;
+
+		//  AB- (    )
+		vector<int> order(n_cycles);
+
+		for (int c = 0; c < n_cycles; ++c)
+			order[c] = c;
+
+		shuffle(order.begin(), order.end(), gen);
+
+		w.pred_a.resize(n);
+		w.pos_a.resize(n);
+
+		for (int v = 0; v < n; ++v)
+			w.pred_a[succ_a[v]] = v;
+
+		for (int i = 0, v = 0; i < n; ++i, v = succ_a[v])
+			w.pos_a[v] = i;
+
+		if ((int)w.stamp.size() != n)
+		{
+			w.stamp.assign(n, 0);
+			w.in_u.assign(n, 0);
+		}
+
+		//       A    
+		w.succ = succ_a;
+		w.pred = w.pred_a;
+		w.best.clear();
+
+		int best_len = INF;
+		double best_eval = 0;
+
+		for (int t = 0; t < min(_n_children, n_cycles); ++t)
+		{
+			int lo = w.cycle_start[order[t]], hi = w.cycle_start[order[t] + 1];
+
+			++w.child;
+			w.changed.clear();
+
+			//  A (v, succ_a v)   B (v, succ_b v):
+			// succ_b v = succ_a u,  u -   
+			int len = _lens[a];
+
+			for (int p = lo; p < hi; ++p)
+			{
+				int v = w.cycles[p];
+
+				len += g[v][succ_b[v]] - g[v][succ_a[v]];
+				w.succ[v] = succ_b[v];
+				w.pred[succ_b[v]] = v;
+
+				touch(w, v);
+			}
+
+			len += merge_subtours(g, w, label_subtours(w, succ_a));
+
+			if (len < _lens[a]) evaluate(w, succ_a, len - _lens[a], best_eval, best_len, len);
+
+			//   A:    
+			//  A      ,  pred  
+			for (int v : w.changed)
+				w.succ[v] = succ_a[v];
+
+			for (int v : w.changed)
+				w.pred[succ_a[v]] = v;
+		}
+
+		return best_len;
+	}
+
+	/// <summary>
+	///    
+	/// </summary>
+	/// <param name="succ">  ( ),   </param>
+	/// <param name="len">   </param>
+	/// <returns>    </returns>
+	int improve(Graph& g, vector<int>& succ, int len)
+	{
+		if (_local_search_type == LocalSearchType::None) return len;
+
+		KOptSolver ls;
+		ls.solve(g, _local_search_type, to_tour(succ), len, &_nn);
+
+		to_succ(ls.solution(), succ);
+
+		return ls.len();
+	}
+
+public:
+
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="pop_size">   </param>
+	/// <param name="n_children">     </param>
+	/// <param name="max_gen">    </param>
+	/// <param name="stall">       </param>
+	/// <param name="local_search_type">    </param>
+	/// <param name="n_jobs">    </param>
+	EAXSolver(int pop_size = 100, int n_children = 30, int max_gen = 1000, int stall = 50,
+		LocalSearchType local_search_type = LocalSearchType::OrOpt, int n_jobs = 1)
+		: _pop_size(max(pop_size, 2)), _n_children(max(n_children, 1)), _max_gen(max_gen), _stall(stall),
+		_n_jobs(n_jobs), _local_search_type(local_search_type), _generations(0) {}
+
+	/// <summary>
+	///  :  -     ,
+	///   
+	/// </summary>
+	/// <param name="g">  </param>
+	void solve(Graph& g) { solve(g, {}); }
+
+	/// <summary>
+	///  :      (,
+	///  ACOSolver),   ,  -  
+	/// (     );
+	/// ,  ,   
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="seeds">   (  ) </param>
+	/// <exception cref="invalid_argument">       </exception>
+	void solve(Graph& g, vector<vector<int>> seeds)
+	{
+		_n_cities = g.n();
+		_generations = 0;
+
+		if (_n_cities < 3)
+		{
+			NNSolver nn;
+			nn.solve(g);
+
+			_solution = nn.solution();
+			_len = nn.len();
+			return;
+		}
+
+		//      
+		for (vector<int>& seed : seeds)
+		{
+			vector<char> seen(_n_cities, 0);
+
+			bool ok = (int)seed.size() == _n_cities + 1 && seed[0] == seed[_n_cities];
+
+			for (int i = 0; ok && i < _n_cities; ++i)
+			{
+				ok = seed[i] >= 0 && seed[i] < _n_cities && !seen[seed[i]];
+				if (ok) seen[seed[i]] = 1;
+			}
+
+			if (!ok) throw invalid_argument("EAX seed: not a tour of this graph");
+		}
+
+		_nn = Neighbors(g, 10, _n_jobs);
+		_work.resize(_n_jobs);
+
+		_succ.assign(_pop_size, {});
+		_lens.assign(_pop_size, 0);
+
+		//  
+		#pragma omp parallel for num_threads(_n_jobs) schedule(dynamic)
+		for (int p = 0; p < _pop_size; ++p)
+		{
+			if (p < (int)seeds.size())
+			{
+				int len = 0;
+
+				for (int i = 0; i < _n_cities; ++i)
+					len += g[seeds[p][i]][seeds[p][i + 1]];
+
+				to_succ(seeds[p], _succ[p]);
+				_lens[p] = len;
+			}
+			else
+			{
+				vector<int> tour;
+				int len = 0;
+
+				if (p == (int)seeds.size())
+				{
+					NNSolver nn;
+					nn.solve(g);
+
+					tour = nn.solution();
+					len = nn.len();
+				}
+				else
+				{
+					tour.resize(_n_cities + 1);
+
+					for (int i = 0; i < _n_cities; ++i)
+						tour[i] = i;
+
+					shuffle(tour.begin(), tour.end() - 1, gen);
+					tour[_n_cities] = tour[0];
+
+					for (int i = 0; i < _n_cities; ++i)
+						len += g[tour[i]][tour[i + 1]];
+				}
+
+				to_succ(tour, _succ[p]);
+				_lens[p] = improve(g, _succ[p], len);
+			}
+		}
+
+		_next_succ = _succ;
+		_next_lens = _lens;
+
+		_freq.assign(_n_cities, {});
+
+		for (int p = 0; p < _pop_size; ++p)
+			for (int v = 0; v < _n_cities; ++v)
+				add_freq(v, _succ[p][v], 1);
+
+		int best = min_element(_lens.begin(), _lens.end()) - _lens.begin();
+		int best_len = _lens[best], since_improvement = 0;
+
+		vector<int> order(_pop_size);
+
+		for (int p = 0; p < _pop_size; ++p)
+			order[p] = p;
+
+		for (; _generations < _max_gen && since_improvement < _stall; ++_generations)
+		{
+			//  (order[i], order[i + 1])  
+			shuffle(order.begin(), order.end(), gen);
+
+			#pragma omp parallel for num_threads(_n_jobs) schedule(dynamic)
+			for (int i = 0; i < _pop_size; ++i)
+			{
+				Workspace& w = _work[omp_get_thread_num()];
+
+				int a = order[i], b = order[(i + 1) % _pop_size];
+				int len = crossover(g, w, a, b);
+
+				if (len < INF)
+				{
+					_next_succ[a] = _succ[a];
+
+					for (auto [v, next] : w.best)
+						_next_succ[a][v] = next;
+
+					_next_lens[a] = improve(g, _next_succ[a], len);
+				}
+				else
+				{
+					_next_succ[a] = _succ[a];
+					_next_lens[a] = _lens[a];
+				}
+			}
+
+			//    
+			for (int p = 0; p < _pop_size; ++p)
+				for (int v = 0; v < _n_cities && _next_lens[p] != _lens[p]; ++v)
+					if (_next_succ[p][v] != _succ[p][v])
+					{
+						add_freq(v, _succ[p][v], -1);
+						add_freq(v, _next_succ[p][v], 1);
+					}
+
+			swap(_succ, _next_succ);
+			swap(_lens, _next_lens);
+
+			int gen_best = min_element(_lens.begin(), _lens.end()) - _lens.begin();
+
+			if (_lens[gen_best] < best_len)
+			{
+				best = gen_best;
+				best_len = _lens[best];
+				since_improvement = 0;
+			}
+			else ++since_improvement;
+		}
+
+		best = min_element(_lens.begin(), _lens.end()) - _lens.begin();
+
+		_solution = to_tour(_succ[best]);
+		_len = _lens[best];
+	}
+
+	/// <summary>
+	///   
+	/// </summary>
+	int generations() { return _generations; }
+
+	/// <summary>
+	///    
+	/// </summary>
+	void print()
+	{
+		cout << "EAXSolver ( ): ";
+
+		for (int i = 0; i < _n_cities; ++i)
+			cout << _solution[i] << " - ";
+
+		cout << _solution.back() << ",   = " << _len << "\n";
+	}
+};
@@ -0,0 +1,346 @@
+#pragma once
+#include <atomic>
+#include <bitset>
+
+#include "KOptSolver.h"
+#include "LowerBound.h"
+
+/// <summary>
+///       :
+///    -   
+/// ( max_dp_cities )      .
+///        0
+/// </summary>
+class ExactSolver : public TSPSolver
+{
+	/// <summary>
+	///   
+	/// </summary>
+	int _n_jobs;
+
+	/// <summary>
+	///  : _dp[mask * m + k] -   
+	///  0   mask,   k (m = n - 1,
+	///  k   k + 1).    
+	/// ,     solve
+	/// </summary>
+	vector<int> _dp;
+
+	/// <summary>
+	///      0:
+	/// _cost[k * m + j] = g[j + 1][k + 1] ( k  )
+	/// </summary>
+	vector<int> _cost;
+
+	/// <summary>
+	/// ,    ,   :
+	///   s   [_layer[s], _layer[s + 1])
+	/// </summary>
+	vector<int> _masks, _layer;
+
+	/// <summary>
+	///       (  )
+	/// </summary>
+	vector<int> _min_out;
+
+	/// <summary>
+	///        (  )
+	/// </summary>
+	vector<vector<int>> _order;
+
+	/// <summary>
+	///    ,     
+	/// </summary>
+	atomic<int> _best_len;
+
+	/// <summary>
+	///  ,     
+	/// </summary>
+	/// <param name="path">     </param>
+	/// <param name="len">   </param>
+	void update_best(vector<int>& path, int len)
+	{
+		int cur = _best_len.load();
+
+		while (len < cur && !_best_len.compare_exchange_weak(cur, len));
+
+		if (len >= cur) return;
+
+		#pragma omp critical (exact_best)
+		if (len < _len)
+		{
+			_solution = path;
+			_solution.push_back(path[0]);
+			_len = len;
+		}
+	}
+
+	/// <summary>
+	///     
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="path">    0 </param>
+	/// <param name="visited">    </param>
+	/// <param name="len">    </param>
+	/// <param name="rest">  _min_out   </param>
+	void branch(Graph& g, vector<int>& path, vector<char>& visited, int len, int rest)
+	{
+		int cur = path.back();
+
+		if ((int)path.size() == _n_cities)
+		{
+			update_best(path, len + g[cur][0]);
+			return;
+		}
+
+		//    ,  ,    
+		if (len + _min_out[cur] + rest >= _best_len.load(memory_order_relaxed)) return;
+
+		for (int next : _order[cur])
+		{
+			if (visited[next]) continue;
+
+			int new_len = len + g[cur][next];
+
+			//     :    
+			if (new_len + rest >= _best_len.load(memory_order_relaxed)) break;
+
+			visited[next] = 1;
+			path.push_back(next);
+
+			branch(g, path, visited, new_len, rest - _min_out[next]);
+
+			path.pop_back();
+			visited[next] = 0;
+		}
+	}
+
+public:
+
+	/// <summary>
+	///   ,   
+	///   (: 2^(n-1) * (n-1) * 4 )
+	/// </summary>
+	static const int max_dp_cities = 21;
+
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="n_jobs">    </param>
+	ExactSolver(int n_jobs = 1) : _n_jobs(n_jobs), _best_len(INF) {}
+
+	/// <summary>
+	///  :  ,  
+	///  ,     
+	/// </summary>
+	/// <param name="g">  </param>
+	void solve(Graph& g)
+	{
+		if (g.n() <= max_dp_cities) solve_dp(g);
+		else solve_bnb(g);
+	}
+
+	/// <summary>
+	///    - , O(2^n * n^2):
+	///    (   ) 
+	///    ,    
+	///     
+	/// </summary>
+	/// <param name="g">  (  max_dp_cities ) </param>
+	void solve_dp(Graph& g)
+	{
+		assert(g.n() <= max_dp_cities);
+
+		_n_cities = g.n();
+
+		if (_n_cities == 1)
+		{
+			_solution = { 0, 0 };
+			_len = 0;
+			return;
+		}
+
+		int m = _n_cities - 1;
+		int full = (1 << m) - 1;
+
+		_cost.resize((size_t)m * m);
+
+		for (int k = 0; k < m; ++k)
+			for (int j = 0; j < m; ++j)
+				_cost[(size_t)k * m + j] = j == k ? 0 : g[j + 1][k + 1];
+
+		//    (    )
+		_layer.assign(m + 2, 0);
+		_masks.resize(full + 1);
+
+		for (int mask = 0; mask <= full; ++mask)
+			++_layer[bitset<32>(mask).count() + 1];
+
+		for (int s = 1; s <= m + 1; ++s)
+			_layer[s] += _layer[s - 1];
+
+		{
+			vector<int> fill_pos(_layer.begin(), _layer.end() - 1);
+
+			for (int mask = 0; mask <= full; ++mask)
+				_masks[fill_pos[bitset<32>(mask).count()]++] = mask;
+		}
+
+		//   - INF (   k  mask),
+		//         
+		_dp.assign((size_t)(full + 1) * m, INF);
+
+		for (int k = 0; k < m; ++k)
+			_dp[((size_t)1 << k) * m + k] = g[0][k + 1];
+
+		for (int s = 2; s <= m; ++s)
+		{
+			#pragma omp parallel for num_threads(_n_jobs) schedule(static)
+			for (int t = _layer[s]; t < _layer[s + 1]; ++t)
+			{
+				int mask = _masks[t];
+
+				for (int k = 0; k < m; ++k)
+				{
+					if (!(mask >> k & 1)) continue;
+
+					const int* prev = &_dp[(size_t)(mask ^ (1 << k)) * m];
+					const int* cost = &_cost[(size_t)k * m];
+
+					//  -  long long: INF  
+					//       int
+					long long best = INF;
+
+					// simd  reduction(min)   OpenMP 2.0 (MSVC)
+#if _OPENMP >= 201307
+					#pragma omp simd reduction(min : best)
+#endif
+					for (int j = 0; j < m; ++j)
+						best = min(best, (long long)prev[j] + cost[j]);
+
+					_dp[(size_t)mask * m + k] = (int)best;
+				}
+			}
+		}
+
+		//     0
+		_len = INF;
+		int last = 0;
+
+		for (int k = 0; k < m; ++k)
+			if (_dp[(size_t)full * m + k] + g[k + 1][0] < _len)
+			{
+				_len = _dp[(size_t)full * m + k] + g[k + 1][0];
+				last = k;
+			}
+
+		//    
+		_solution.assign(_n_cities + 1, 0);
+
+		for (int mask = full, pos = m; mask; --pos)
+		{
+			_solution[pos] = last + 1;
+
+			int prev = mask ^ (1 << last);
+			int value = _dp[(size_t)mask * m + last];
+
+			if (prev)
+				for (int j = 0; j < m; ++j)
+					if ((prev >> j & 1) && _dp[(size_t)prev * m + j] + _cost[(size_t)last * m + j] == value)
+					{
+						last = j;
+						break;
+					}
+
+			mask = prev;
+		}
+	}
+
+	/// <summary>
+	///    :   -  ,
+	///  3-opt (  ,   
+	///    LowerBound.h).     
+	///     ,  
+	/// </summary>
+	/// <param name="g">  </param>
+	void solve_bnb(Graph& g)
+	{
+		_n_cities = g.n();
+
+		if (_n_cities < 4)
+		{
+			solve_dp(g);
+			return;
+		}
+
+		//  
+		NNSolver nn;
+		nn.solve(g);
+
+		KOptSolver ls;
+		ls.solve(g, LocalSearchType::ThreeOpt, nn.solution(), nn.len());
+
+		_solution = ls.solution();
+		_solution.pop_back();
+		rotate(_solution.begin(), find(_solution.begin(), _solution.end(), 0), _solution.end());
+		_solution.push_back(0);
+
+		_len = ls.len();
+		_best_len = _len;
+
+		//      -  
+		if (_len <= tour_lower_bound(g, _n_jobs)) return;
+
+		//    
+		_min_out.assign(_n_cities, INF);
+		_order.assign(_n_cities, {});
+
+		int rest = 0;
+
+		for (int v = 0; v < _n_cities; ++v)
+		{
+			for (int u = 0; u < _n_cities; ++u)
+				if (u != v)
+				{
+					_min_out[v] = min(_min_out[v], g[v][u]);
+					_order[v].push_back(u);
+				}
+
+			sort(_order[v].begin(), _order[v].end(), [&](int a, int b) { return g[v][a] < g[v][b]; });
+
+			if (v != 0) rest += _min_out[v];
+		}
+
+		// :     
+		int n_tasks = (_n_cities - 1) * (_n_cities - 1);
+
+		#pragma omp parallel for num_threads(_n_jobs) schedule(dynamic)
+		for (int t = 0; t < n_tasks; ++t)
+		{
+			int a = t / (_n_cities - 1) + 1, b = t % (_n_cities - 1) + 1;
+
+			if (a == b) continue;
+
+			vector<int> path = { 0, a, b };
+			path.reserve(_n_cities);
+
+			vector<char> visited(_n_cities, 0);
+			visited[0] = visited[a] = visited[b] = 1;
+
+			branch(g, path, visited, g[0][a] + g[a][b], rest - _min_out[a] - _min_out[b]);
+		}
+	}
+
+	/// <summary>
+	///    
+	/// </summary>
+	void print()
+	{
+		cout << "ExactSolver ( ): ";
+
+		for (int i = 0; i < _n_cities; ++i)
+			cout << _solution[i] << " - ";
+
+		cout << _solution.back() << ",   = " << _len << "\n";
+	}
+};
@@ -0,0 +1,164 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include "NNSolver.h"
+#include "KOptSolver.h"
+
+/// <summary>
+/// GRASP:     
+/// (NNSolver   )    .
+///      ;    
+///  (  )    , 
+///     (,  )
+/// </summary>
+class GRASPSolver : public TSPSolver
+{
+	/// <summary>
+	///  :
+	/// <para> - n_starts ( ) </para>
+	/// <para> - rcl (    ) </para>
+	/// <para> - n_jobs (  ) </para>
+	/// </summary>
+	int _n_starts, _rcl, _n_jobs;
+
+	/// <summary>
+	///     
+	/// </summary>
+	LocalSearchType _local_search_type;
+
+	/// <summary>
+	///      (0 - ): 
+	///  ,    ( 
+	///  ,   )
+	/// </summary>
+	double _time_limit;
+
+	/// <summary>
+	///   
+	/// </summary>
+	atomic<int> _done;
+
+	/// <summary>
+	///    
+	/// </summary>
+	atomic<int> _best_len;
+
+	/// <summary>
+	///   :     
+	/// </summary>
+	struct Workspace
+	{
+		NNSolver nn;
+		KOptSolver ls;
+		vector<int> best;
+		int best_len = INF;
+
+		Workspace(int rcl) : nn(rcl) {}
+	};
+
+	vector<Workspace> _work;
+
+public:
+
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="n_starts">   </param>
+	/// <param name="rcl">      </param>
+	/// <param name="local_search_type">     </param>
+	/// <param name="n_jobs">    </param>
+	/// <param name="time_limit">      (0 - ) </param>
+	/// <exception cref="invalid_argument"> n_starts  n_jobs  , time_limit  </exception>
+	GRASPSolver(int n_starts = 1000, int rcl = 3, LocalSearchType local_search_type = LocalSearchType::TwoOpt,
+		int n_jobs = 1, double time_limit = 0)
+		: _n_starts(n_starts), _rcl(rcl), _n_jobs(n_jobs), _local_search_type(local_search_type),
+		_time_limit(time_limit), _done(0), _best_len(INF)
+	{
+		if (n_starts <= 0) throw invalid_argument("GRASP: n_starts must be positive");
+		if (n_jobs <= 0) throw invalid_argument("GRASP: n_jobs must be positive");
+		if (time_limit < 0) throw invalid_argument("GRASP: time_limit must be non-negative");
+	}
+
+	/// <summary>
+	///  
+	/// </summary>
+	/// <param name="g">  </param>
+	void solve(Graph& g)
+	{
+		_n_cities = g.n();
+		_done = 0;
+		_best_len = INF;
+
+		//    Or-opt  Or-3opt,   
+		Neighbors nn;
+
+		if (_local_search_type == LocalSearchType::OrOpt || _local_search_type == LocalSearchType::OrThreeOpt)
+			nn = Neighbors(g, 10, _n_jobs);
+
+		_work.clear();
+		_work.reserve(_n_jobs);
+
+		for (int t = 0; t < _n_jobs; ++t)
+			_work.emplace_back(_rcl);
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+		#pragma omp parallel for num_threads(_n_jobs) schedule(dynamic)
+		for (int s = 0; s < _n_starts; ++s)
+		{
+			if (s > 0 && _time_limit > 0 && chrono::duration<double>(chrono::steady_clock::now() - start).count() > _time_limit)
+				continue;
+
+			Workspace& w = _work[omp_get_thread_num()];
+
+			w.nn.solve(g);
+			w.ls.solve(g, _local_search_type, w.nn.solution(), w.nn.len(), &nn);
+
+			++_done;
+
+			if (w.ls.len() >= w.best_len) continue;
+
+			w.best = w.ls.solution();
+			w.best_len = w.ls.len();
+
+			int cur = _best_len.load();
+
+			while (w.best_len < cur && !_best_len.compare_exchange_weak(cur, w.best_len));
+		}
+
+		//   -  ,     
+		_len = INF;
+
+		for (Workspace& w : _work)
+			if (w.best_len < _len)
+			{
+				_solution = w.best;
+				_len = w.best_len;
+			}
+	}
+
+	/// <summary>
+	///     (    )
+	/// </summary>
+	int best_len() { return _best_len.load(); }
+
+	/// <summary>
+	///    (    )
+	/// </summary>
+	int starts_done() { return _done.load(); }
+
+	/// <summary>
+	///    
+	/// </summary>
+	void print()
+	{
+		cout << "GRASPSolver ( ): ";
+
+		for (int i = 0; i < _n_cities; ++i)
+			cout << _solution[i] << " - ";
+
+		cout << _solution.back() << ",   = " << _len << "\n";
+	}
+};
@@ -1,7 +1,14 @@
 #pragma once
 #include <fstream>
 #include <cassert>
+#include <cmath>
 #include <vector>
+
+// ,  <windows.h>,   using namespace std:
+//   MSVC (C++17) byte  Windows   std::byte
+#include "Affinity.h"
+#include "Arena.h"
+
 using namespace std;
 
 /// <summary>
@@ -15,36 +22,164 @@ class Graph
 	int _N;
 
 	/// <summary>
-	///   
+	///    , 
+	///    (. Graph(vector<int>, int))
+	/// </summary>
+	vector<int> _storage;
+
+	/// <summary>
+	///    ,  
+	/// (    ).    :
+	///     NUMA ,    ,
+	///    
+	/// </summary>
+	Arena _arena;
+
+	/// <summary>
+	///   :  i 
+	///  _data + i * _stride
+	/// </summary>
+	int* _data;
+
+	/// <summary>
+	///  ( )    
+	/// </summary>
+	int _stride;
+
+	/// <summary>
+	///   (    )
 	/// </summary>
-	vector<vector<int>> _adjMat;
+	vector<double> _x, _y;
+
+	/// <summary>
+	///  ,    
+	/// (  , . fill_rows)
+	/// </summary>
+	int _n_jobs;
+
+	/// <summary>
+	///    : n x n,  
+	/// ( )
+	/// </summary>
+	void own(int n)
+	{
+		_N = n;
+		_arena.reserve((size_t)n * n * sizeof(int));
+		_data = _arena.allocate<int>((size_t)n * n);
+		_stride = n;
+	}
+
+	/// <summary>
+	///     src ( 
+	///   - ,     
+	///       n_jobs   )
+	/// </summary>
+	/// <param name="src">  n x n </param>
+	/// <param name="src_stride">  ( )    src </param>
+	void fill_rows(const int* src, int src_stride)
+	{
+		#pragma omp parallel for num_threads(_n_jobs) schedule(static)
+		for (int i = 0; i < _N; ++i)
+			copy(src + (size_t)i * src_stride, src + (size_t)i * src_stride + _N, _data + (size_t)i * _stride);
+	}
 
 public:
 
-	Graph() {}
+	Graph() : _N(0), _data(nullptr), _stride(0), _n_jobs(1) {}
 
 	/// <summary>
 	/// :   
 	///  
 	/// </summary>
 	/// <param name="filePath">    </param>
-	Graph(string filePath)
+	/// <param name="n_jobs">  ,   (  ) </param>
+	Graph(string filePath, int n_jobs = 1) : _n_jobs(n_jobs)
 	{
 		ifstream fin(filePath);
 		assert(fin.is_open());
 
-		fin >> _N;
+		int n;
+		fin >> n;
 
-		_adjMat.resize(_N);
+		//   ,   
+		//   
+		vector<int> values((size_t)n * n);
 
-		for (int i = 0; i < _N; ++i)
-			_adjMat[i].resize(_N);
+		for (int& value : values)
+			fin >> value;
+
+		fin.close();
+
+		own(n);
+		fill_rows(values.data(), n);
+	}
+
+	/// <summary>
+	/// :     .
+	///     
+	/// </summary>
+	/// <param name="data">   </param>
+	/// <param name="n">   </param>
+	/// <param name="stride">  ( )    </param>
+	Graph(int* data, int n, int stride) : _N(n), _data(data), _stride(stride), _n_jobs(1) {}
+
+	/// <summary>
+	/// :     
+	/// ( ),     
+	/// </summary>
+	/// <param name="data">   n x n </param>
+	/// <param name="n">   </param>
+	Graph(vector<int> data, int n) : _N(n), _storage(move(data)), _stride(n), _n_jobs(1)
+	{
+		assert(_storage.size() == (size_t)n * n);
+		_data = _storage.data();
+	}
+
+	/// <summary>
+	/// :     ,
+	///     ( EUC_2D  TSPLIB)
+	/// </summary>
+	/// <param name="x">   </param>
+	/// <param name="y">   </param>
+	/// <param name="n_jobs">  ,   (  ) </param>
+	Graph(const vector<double>& x, const vector<double>& y, int n_jobs = 1) : _x(x), _y(y), _n_jobs(n_jobs)
+	{
+		assert(x.size() == y.size());
+
+		own(x.size());
 
+		#pragma omp parallel for num_threads(_n_jobs) schedule(static)
 		for (int i = 0; i < _N; ++i)
 			for (int j = 0; j < _N; ++j)
-				fin >> _adjMat[i][j];
+				(*this)[i][j] = (int)(sqrt((x[i] - x[j]) * (x[i] - x[j]) + (y[i] - y[j]) * (y[i] - y[j])) + 0.5);
+	}
 
-		fin.close();
+	Graph(const Graph& other) : _N(other._N), _storage(other._storage), _data(other._data),
+		_stride(other._stride), _x(other._x), _y(other._y), _n_jobs(other._n_jobs)
+	{
+		if (!other._arena.empty())
+		{
+			own(_N);
+			fill_rows(other._data, other._stride);
+		}
+		else if (!_storage.empty()) _data = _storage.data();
+	}
+
+	Graph(Graph&& other) noexcept : _N(other._N), _storage(move(other._storage)), _arena(move(other._arena)),
+		_data(other._data), _stride(other._stride), _x(move(other._x)), _y(move(other._y)), _n_jobs(other._n_jobs) {}
+
+	Graph& operator = (Graph other)
+	{
+		_N = other._N;
+		_storage = move(other._storage);
+		_arena = move(other._arena);
+		_data = other._data;
+		_stride = other._stride;
+		_x = move(other._x);
+		_y = move(other._y);
+		_n_jobs = other._n_jobs;
+
+		return *this;
 	}
 
 	/// <summary>
@@ -53,10 +188,38 @@ public:
 	/// <returns>     </returns>
 	int n() { return _N; }
 
+	/// <summary>
+	///      
+	/// </summary>
+	bool is_view() { return _storage.empty() && _arena.empty() && _data != nullptr; }
+
+	/// <summary>
+	///     ( )
+	/// </summary>
+	bool is_symmetric()
+	{
+		for (int i = 0; i < _N; ++i)
+			for (int j = i + 1; j < _N; ++j)
+				if ((*this)[i][j] != (*this)[j][i]) return false;
+
+		return true;
+	}
+
+	/// <summary>
+	///    
+	/// </summary>
+	bool has_coords() { return !_x.empty(); }
+
+	/// <summary>
+	///   ( )
+	/// </summary>
+	vector<double>& x() { return _x; }
+	vector<double>& y() { return _y; }
+
 	/// <summary>
 	///   
 	/// </summary>
 	/// <param name="i">  </param>
 	/// <returns>   ,     i </returns>
-	vector<int>& operator [] (int i) { return _adjMat[i]; }
+	int* operator [] (int i) { return _data + (size_t)i * _stride; }
 };
\ No newline at end of file
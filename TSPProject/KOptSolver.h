@@ -1,5 +1,107 @@
 #pragma once
+#include <stdexcept>
+
 #include "TSPSolver.h"
+#include "Async.h"
+
+/// <summary>
+///    (k-opt ):
+/// <para> - None (  ) </para>
+/// <para> - TwoOpt (2-opt) </para>
+/// <para> - TwoHalfOpt (2.5-opt) </para>
+/// <para> - ThreeOpt (3-opt) </para>
+/// <para> - OrOpt (Or-opt,    ) </para>
+/// <para> - OrThreeOpt (Or-3opt, 3-opt  ) </para>
+/// </summary>
+enum class LocalSearchType { None, TwoOpt, TwoHalfOpt, ThreeOpt, OrOpt, OrThreeOpt };
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="name"> : None, 2-opt, 2.5-opt, 3-opt, Or-opt, Or-3opt </param>
+/// <returns>    </returns>
+LocalSearchType to_local_search_type(const string& name)
+{
+	if (name == "None") return LocalSearchType::None;
+	if (name == "2-opt") return LocalSearchType::TwoOpt;
+	if (name == "2.5-opt") return LocalSearchType::TwoHalfOpt;
+	if (name == "3-opt") return LocalSearchType::ThreeOpt;
+	if (name == "Or-opt") return LocalSearchType::OrOpt;
+	if (name == "Or-3opt") return LocalSearchType::OrThreeOpt;
+
+	throw invalid_argument("unknown local search type: " + name);
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="type">    </param>
+/// <returns> : None, 2-opt, 2.5-opt, 3-opt, Or-opt, Or-3opt </returns>
+string to_string(LocalSearchType type)
+{
+	switch (type)
+	{
+	case LocalSearchType::TwoOpt: return "2-opt";
+	case LocalSearchType::TwoHalfOpt: return "2.5-opt";
+	case LocalSearchType::ThreeOpt: return "3-opt";
+	case LocalSearchType::OrOpt: return "Or-opt";
+	case LocalSearchType::OrThreeOpt: return "Or-3opt";
+	default: return "None";
+	}
+}
+
+/// <summary>
+///     
+/// (   -   
+///   )
+/// </summary>
+class Neighbors
+{
+public:
+
+	/// <summary>
+	///  :
+	/// <para> - out (out[i] -  j   g[i][j]) </para>
+	/// <para> - in (in[i] -  j   g[j][i]) </para>
+	/// </summary>
+	vector<vector<int>> out, in;
+
+	Neighbors() {}
+
+	/// <summary>
+	/// :    k  
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="k">    </param>
+	/// <param name="n_jobs">    </param>
+	Neighbors(Graph& g, int k, int n_jobs = 1)
+	{
+		int n = g.n();
+		k = min(k, n - 1);
+
+		out = vector<vector<int>>(n, vector<int>(k));
+		in = vector<vector<int>>(n, vector<int>(k));
+
+		#pragma omp parallel for num_threads(n_jobs)
+		for (int i = 0; i < n; ++i)
+		{
+			vector<int> ids;
+
+			for (int j = 0; j < n; ++j)
+				if (j != i) ids.push_back(j);
+
+			partial_sort(ids.begin(), ids.begin() + k, ids.end(),
+				[&](int a, int b) { return g[i][a] < g[i][b]; });
+
+			copy(ids.begin(), ids.begin() + k, out[i].begin());
+
+			partial_sort(ids.begin(), ids.begin() + k, ids.end(),
+				[&](int a, int b) { return g[a][i] < g[b][i]; });
+
+			copy(ids.begin(), ids.begin() + k, in[i].begin());
+		}
+	}
+};
 
 /// <summary>
 ///    
@@ -10,7 +112,52 @@ class KOptSolver : public TSPSolver
 	/// <summary>
 	///  
 	/// </summary>
-	string _type;
+	LocalSearchType _type;
+
+	/// <summary>
+	///    ( Or-opt  Or-3opt)
+	/// </summary>
+	Neighbors* _nn;
+
+	/// <summary>
+	///  :    
+	/// (   ,    )
+	/// </summary>
+	CancellationToken _cancel;
+
+	/// <summary>
+	///    : _solution[_pos[v]] = v
+	/// </summary>
+	vector<int> _pos;
+
+	/// <summary>
+	///       [l, r]
+	/// </summary>
+	void update_pos(int l, int r)
+	{
+		for (int x = l; x <= r; ++x)
+			_pos[_solution[x]] = x;
+	}
+
+	/// <summary>
+	///   : _succ[x] = g[_solution[x]][_solution[x + 1]].
+	///        
+	///       
+	/// </summary>
+	vector<int> _succ;
+
+	/// <summary>
+	///    ,    [l, r]
+	/// </summary>
+	/// <param name="g">  </param>
+	void update_succ(Graph& g, int l, int r)
+	{
+		l = max(l, 0);
+		r = min(r, _n_cities - 1);
+
+		for (int x = l; x <= r; ++x)
+			_succ[x] = g[_solution[x]][_solution[x + 1]];
+	}
 
 	/// <summary>
 	///  2-opt
@@ -18,11 +165,13 @@ class KOptSolver : public TSPSolver
 	/// <param name="g">  </param>
 	void two_opt(Graph& g)
 	{
+		if (_cancel.cancelled()) return;
+
 		//     
 		vector<int> pref(_n_cities + 1);
 
 		for (int i = 1; i <= _n_cities; ++i)
-			pref[i] = pref[i - 1] + g[_solution[i - 1]][_solution[i]];
+			pref[i] = pref[i - 1] + _succ[i - 1];
 
 		//      
 		vector<int> pref_rev(_n_cities + 1);
@@ -31,6 +180,9 @@ class KOptSolver : public TSPSolver
 			pref_rev[i] = pref_rev[i - 1] + g[_solution[_n_cities - i + 1]][_solution[_n_cities - i]];
 		
 		for (int i = 0; i < _n_cities - 2; ++i)
+		{
+			if (_cancel.cancelled()) return;
+
 			for (int j = i + 2; j < _n_cities; ++j)
 			{
 				//   (i, i + 1)  (j, j + 1)
@@ -53,12 +205,14 @@ class KOptSolver : public TSPSolver
 				if (new_len < _len)
 				{
 					reverse(_solution.begin() + i + 1, _solution.begin() + j + 1);
+					update_succ(g, i, j);
 					_len = new_len;
 
 					two_opt(g);
 					return;
 				}
 			}
+		}
 	}
 
 	/// <summary>
@@ -67,15 +221,17 @@ class KOptSolver : public TSPSolver
 	/// <param name="g">  </param>
 	void two_half_opt(Graph& g)
 	{
+		if (_cancel.cancelled()) return;
+
 		for (int i = 1; i < _n_cities - 2; ++i)
 		{
 			//   
 			int new_len = _len;
 
 			// (n - 1) -> 0 -> 1 -> ... -> i -> i + 1 -> ...
-			new_len -= g[_solution[_n_cities - 1]][_solution[0]];
-			new_len -= g[_solution[0]][_solution[1]];
-			new_len -= g[_solution[i]][_solution[i + 1]];
+			new_len -= _succ[_n_cities - 1];
+			new_len -= _succ[0];
+			new_len -= _succ[i];
 
 			// i -> 0 -> i + 1 -> ... -> (n - 1) -> 1 -> ...
 			new_len += g[_solution[i]][_solution[0]];
@@ -85,6 +241,7 @@ class KOptSolver : public TSPSolver
 			if (new_len < _len)
 			{
 				rotate(_solution.begin() + 1, _solution.begin() + i + 1, _solution.begin() + _n_cities);
+				update_succ(g, 0, _n_cities - 1);
 				_len = new_len;
 
 				two_half_opt(g);
@@ -93,15 +250,18 @@ class KOptSolver : public TSPSolver
 		}
 
 		for (int i = 1; i < _n_cities; ++i)
+		{
+			if (_cancel.cancelled()) return;
+
 			for (int j = 1; j < _n_cities - 2; ++j)
 			{
 				//   
 				int new_len = _len;
 
 				// (i - 1) -> i -> (i + 1) -> ... -> (i + j) -> (i + j + 1) -> ...
-				new_len -= g[_solution[i - 1]][_solution[i]];
-				new_len -= g[_solution[i]][_solution[i + 1]];
-				new_len -= g[_solution[(i + j) % _n_cities]][_solution[(i + j + 1) % _n_cities]];
+				new_len -= _succ[i - 1];
+				new_len -= _succ[i];
+				new_len -= _succ[(i + j) % _n_cities];
 
 				// (i + j) -> i -> (i + j + 1) -> ... -> (i - 1) -> (i + 1) -> ...
 				new_len += g[_solution[(i + j) % _n_cities]][_solution[i]];
@@ -116,12 +276,14 @@ class KOptSolver : public TSPSolver
 					int pos3 = i + 1 - (i + j) / _n_cities;
 
 					rotate(_solution.begin() + pos1, _solution.begin() + pos3, _solution.begin() + pos2 + 1);
+					update_succ(g, pos1 - 1, pos2);
 					_len = new_len;
 
 					two_half_opt(g);
 					return;
 				}
 			}
+		}
 	}
 
 	/// <summary>
@@ -130,7 +292,12 @@ class KOptSolver : public TSPSolver
 	/// <param name="g">  </param>
 	void three_opt(Graph& g)
 	{
+		if (_cancel.cancelled()) return;
+
 		for (int i = 0; i < _n_cities - 2; ++i)
+		{
+			if (_cancel.cancelled()) return;
+
 			for (int j = i + 1; j < _n_cities - 1; ++j)
 				for (int k = j + 1; k < _n_cities; ++k)
 				{
@@ -138,9 +305,9 @@ class KOptSolver : public TSPSolver
 					int new_len = _len;
 
 					// ... -> x -> (x + 1) -> ...
-					new_len -= g[_solution[i]][_solution[i + 1]];
-					new_len -= g[_solution[j]][_solution[j + 1]];
-					new_len -= g[_solution[k]][_solution[k + 1]];
+					new_len -= _succ[i];
+					new_len -= _succ[j];
+					new_len -= _succ[k];
 
 					// i -> j + 1 -> ... -> k -> i + 1 -> ... -> j -> k + 1 -> ... 
 					new_len += g[_solution[i]][_solution[j + 1]];
@@ -150,12 +317,294 @@ class KOptSolver : public TSPSolver
 					if (new_len < _len)
 					{
 						rotate(_solution.begin() + i + 1, _solution.begin() + j + 1, _solution.begin() + k + 1);
+						update_succ(g, i, k);
 						_len = new_len;
 
 						three_opt(g);
 						return;
 					}
 				}
+		}
+	}
+
+	/// <summary>
+	///  Or-opt:    1-3 
+	///       .  
+	///   O(1),     ,
+	///     
+	/// </summary>
+	/// <param name="g">  </param>
+	void or_opt(Graph& g)
+	{
+		_pos.resize(_n_cities);
+		update_pos(0, _n_cities - 1);
+
+		bool improved = true;
+
+		while (improved && !_cancel.cancelled())
+		{
+			improved = false;
+
+			for (int i = 1; i < _n_cities; ++i)
+				for (int l = 1; l <= 3 && i + l <= _n_cities; ++l)
+				{
+					// ... -> prev -> [first -> ... -> last] -> next -> ...
+					int prev = _solution[i - 1], first = _solution[i];
+					int last = _solution[i + l - 1], next = _solution[i + l];
+
+					//    
+					int gain = _succ[i - 1] + _succ[i + l - 1] - g[prev][next];
+
+					//   p  p + 1
+					int best_p = -1, best_delta = 0;
+
+					//  : c -> first
+					for (int c : _nn->in[first])
+					{
+						if (g[c][first] >= gain) break;
+
+						int p = _pos[c];
+						if (p >= i - 1 && p < i + l) continue;
+
+						int delta = g[c][first] + g[last][_solution[p + 1]] - _succ[p] - gain;
+						if (delta < best_delta) { best_delta = delta; best_p = p; }
+					}
+
+					//  : last -> c
+					for (int c : _nn->out[last])
+					{
+						if (g[last][c] >= gain) break;
+
+						int p = (_pos[c] == 0 ? _n_cities : _pos[c]) - 1;
+						if (p >= i - 1 && p < i + l) continue;
+
+						int delta = g[_solution[p]][first] + g[last][c] - _succ[p] - gain;
+						if (delta < best_delta) { best_delta = delta; best_p = p; }
+					}
+
+					if (best_p == -1) continue;
+
+					// ... -> p -> [first -> ... -> last] -> p + 1 -> ...
+					if (best_p < i)
+					{
+						rotate(_solution.begin() + best_p + 1, _solution.begin() + i, _solution.begin() + i + l);
+						update_pos(best_p + 1, i + l - 1);
+						update_succ(g, best_p, i + l - 1);
+					}
+					else
+					{
+						rotate(_solution.begin() + i, _solution.begin() + i + l, _solution.begin() + best_p + 1);
+						update_pos(i, best_p);
+						update_succ(g, i - 1, best_p);
+					}
+
+					_len += best_delta;
+					improved = true;
+					break;
+				}
+		}
+	}
+
+	/// <summary>
+	///  Or-3opt:  3-opt   
+	/// (i -> j + 1 -> ... -> k -> i + 1 -> ... -> j -> k + 1),
+	///        ,
+	///     O(1)
+	/// </summary>
+	/// <param name="g">  </param>
+	void or_three_opt(Graph& g)
+	{
+		_pos.resize(_n_cities);
+		update_pos(0, _n_cities - 1);
+
+		bool improved = true;
+
+		while (improved && !_cancel.cancelled())
+		{
+			improved = false;
+
+			for (int i = 0; i < _n_cities - 2; ++i)
+			{
+				int a = _solution[i], b = _solution[i + 1];
+				int g1 = _succ[i];
+
+				for (int d : _nn->out[a])
+				{
+					//  : i -> j + 1
+					int j = _pos[d] - 1;
+					if (j <= i) continue;
+
+					int c = _solution[j];
+					int g2 = g1 - g[a][d] + _succ[j];
+
+					for (int e : _nn->in[b])
+					{
+						//  : k -> i + 1
+						int k = _pos[e];
+						if (k <= j) continue;
+
+						int f = _solution[k + 1];
+						int delta = g[c][f] - _succ[k] - (g2 - g[e][b]);
+
+						if (delta < 0)
+						{
+							rotate(_solution.begin() + i + 1, _solution.begin() + j + 1, _solution.begin() + k + 1);
+							update_pos(i + 1, k);
+							update_succ(g, i, k);
+
+							_len += delta;
+							improved = true;
+							break;
+						}
+					}
+
+					if (improved) break;
+				}
+
+				if (improved) break;
+			}
+		}
+	}
+
+	/// <summary>
+	///    :   ,
+	///  i < j <= k   ( 2-opt j = k).
+	///     ,    [i, k]
+	/// </summary>
+	struct Move { int delta, i, j, k; };
+
+	/// <summary>
+	///     ( [i, k]  ),
+	///    .     
+	/// </summary>
+	/// <param name="moves">    </param>
+	/// <returns>   </returns>
+	vector<Move> select_moves(vector<Move>& moves)
+	{
+		sort(moves.begin(), moves.end(), [](const Move& a, const Move& b) { return a.delta < b.delta; });
+
+		vector<char> used(_n_cities, 0);
+		vector<Move> selected;
+
+		for (Move& m : moves)
+		{
+			bool ok = true;
+
+			for (int x = m.i; x <= m.k && ok; ++x)
+				ok = !used[x];
+
+			if (!ok) continue;
+
+			fill(used.begin() + m.i, used.begin() + m.k + 1, 1);
+			selected.push_back(m);
+		}
+
+		return selected;
+	}
+
+	/// <summary>
+	///    2-opt :   i 
+	///    (i, j),     
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="n_jobs">    </param>
+	/// <returns>        </returns>
+	bool parallel_two_opt_step(Graph& g, int n_jobs)
+	{
+		//       (. two_opt)
+		vector<int> pref(_n_cities + 1), pref_rev(_n_cities + 1);
+
+		for (int i = 1; i <= _n_cities; ++i)
+		{
+			pref[i] = pref[i - 1] + _succ[i - 1];
+			pref_rev[i] = pref_rev[i - 1] + g[_solution[_n_cities - i + 1]][_solution[_n_cities - i]];
+		}
+
+		vector<Move> best(_n_cities, { 0, 0, 0, 0 });
+
+		#pragma omp parallel for num_threads(n_jobs) schedule(dynamic, 16)
+		for (int i = 0; i < _n_cities - 2; ++i)
+		{
+			Move m = { 0, i, i, i };
+
+			for (int j = i + 2; j < _n_cities; ++j)
+			{
+				//   i -> j  (i + 1) -> (j + 1),  (i + 1) ... j 
+				int delta = g[_solution[i]][_solution[j]] + g[_solution[i + 1]][_solution[j + 1]]
+					+ pref_rev[_n_cities - i - 1] - pref_rev[_n_cities - j] - (pref[j + 1] - pref[i]);
+
+				if (delta < m.delta) m = { delta, i, j, j };
+			}
+
+			best[i] = m;
+		}
+
+		vector<Move> moves;
+
+		for (Move& m : best)
+			if (m.delta < 0) moves.push_back(m);
+
+		if (moves.empty()) return false;
+
+		for (Move& m : select_moves(moves))
+		{
+			reverse(_solution.begin() + m.i + 1, _solution.begin() + m.j + 1);
+			update_succ(g, m.i, m.j);
+			_len += m.delta;
+		}
+
+		return true;
+	}
+
+	/// <summary>
+	///    3-opt  ( 
+	///  ,   three_opt):   i  
+	///   (i, j, k),     
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="n_jobs">    </param>
+	/// <returns>        </returns>
+	bool parallel_three_opt_step(Graph& g, int n_jobs)
+	{
+		vector<Move> best(_n_cities, { 0, 0, 0, 0 });
+
+		#pragma omp parallel for num_threads(n_jobs) schedule(dynamic)
+		for (int i = 0; i < _n_cities - 2; ++i)
+		{
+			Move m = { 0, i, i, i };
+
+			for (int j = i + 1; j < _n_cities - 1; ++j)
+			{
+				//   i -> (j + 1)    (i, i + 1), (j, j + 1)
+				int part = g[_solution[i]][_solution[j + 1]] - _succ[i] - _succ[j];
+
+				for (int k = j + 1; k < _n_cities; ++k)
+				{
+					//   k -> (i + 1)  j -> (k + 1),   (k, k + 1)
+					int delta = part + g[_solution[k]][_solution[i + 1]] + g[_solution[j]][_solution[k + 1]] - _succ[k];
+
+					if (delta < m.delta) m = { delta, i, j, k };
+				}
+			}
+
+			best[i] = m;
+		}
+
+		vector<Move> moves;
+
+		for (Move& m : best)
+			if (m.delta < 0) moves.push_back(m);
+
+		if (moves.empty()) return false;
+
+		for (Move& m : select_moves(moves))
+		{
+			rotate(_solution.begin() + m.i + 1, _solution.begin() + m.j + 1, _solution.begin() + m.k + 1);
+			update_succ(g, m.i, m.k);
+			_len += m.delta;
+		}
+
+		return true;
 	}
 
 public:
@@ -165,6 +614,55 @@ public:
 	/// </summary>
 	KOptSolver() {}
 
+	/// <summary>
+	///    (  )
+	/// </summary>
+	/// <param name="token">   </param>
+	void set_cancel_token(CancellationToken token) { _cancel = token; }
+
+	/// <summary>
+	///  :      
+	/// </summary>
+	/// <typeparam name="Type">    </typeparam>
+	/// <param name="g">  </param>
+	/// <param name="init_sol">   </param>
+	/// <param name="init_len">    </param>
+	/// <param name="nn">   ( Or-opt  Or-3opt),    </param>
+	template <LocalSearchType Type>
+	void solve(Graph& g, vector<int> init_sol, int init_len, Neighbors* nn = nullptr)
+	{
+		_type = Type;
+
+		_solution = init_sol;
+		_len = init_len;
+
+		_n_cities = init_sol.size() - 1;
+
+		_succ.resize(_n_cities);
+		update_succ(g, 0, _n_cities - 1);
+
+		if constexpr (Type == LocalSearchType::TwoOpt) two_opt(g);
+		else if constexpr (Type == LocalSearchType::TwoHalfOpt) two_half_opt(g);
+		else if constexpr (Type == LocalSearchType::ThreeOpt) three_opt(g);
+		else if constexpr (Type == LocalSearchType::OrOpt || Type == LocalSearchType::OrThreeOpt)
+		{
+			Neighbors own;
+
+			if (nn == nullptr)
+			{
+				own = Neighbors(g, 10);
+				nn = &own;
+			}
+
+			_nn = nn;
+
+			if constexpr (Type == LocalSearchType::OrOpt) or_opt(g);
+			else or_three_opt(g);
+
+			_nn = nullptr;
+		}
+	}
+
 	/// <summary>
 	///  
 	/// </summary>
@@ -172,8 +670,50 @@ public:
 	/// <param name="type">    </param>
 	/// <param name="init_sol">   </param>
 	/// <param name="init_len">    </param>
-	void solve(Graph& g, string type, vector<int> init_sol, int init_len)
+	/// <param name="nn">   ( Or-opt  Or-3opt),    </param>
+	void solve(Graph& g, LocalSearchType type, vector<int> init_sol, int init_len, Neighbors* nn = nullptr)
 	{
+		switch (type)
+		{
+		case LocalSearchType::TwoOpt: solve<LocalSearchType::TwoOpt>(g, init_sol, init_len, nn); break;
+		case LocalSearchType::TwoHalfOpt: solve<LocalSearchType::TwoHalfOpt>(g, init_sol, init_len, nn); break;
+		case LocalSearchType::ThreeOpt: solve<LocalSearchType::ThreeOpt>(g, init_sol, init_len, nn); break;
+		case LocalSearchType::OrOpt: solve<LocalSearchType::OrOpt>(g, init_sol, init_len, nn); break;
+		case LocalSearchType::OrThreeOpt: solve<LocalSearchType::OrThreeOpt>(g, init_sol, init_len, nn); break;
+		default: solve<LocalSearchType::None>(g, init_sol, init_len, nn); break;
+		}
+	}
+
+	/// <summary>
+	///  
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="type">  : 2-opt, 2.5-opt, 3-opt, Or-opt, Or-3opt </param>
+	/// <param name="init_sol">   </param>
+	/// <param name="init_len">    </param>
+	/// <param name="nn">   ( Or-opt  Or-3opt),    </param>
+	void solve(Graph& g, string type, vector<int> init_sol, int init_len, Neighbors* nn = nullptr)
+	{
+		solve(g, to_local_search_type(type), init_sol, init_len, nn);
+	}
+
+	/// <summary>
+	///      : 
+	///     ,  
+	///    .   
+	///      
+	/// </summary>
+	/// <param name="g">  </param>
+	/// <param name="type">  : TwoOpt  ThreeOpt </param>
+	/// <param name="init_sol">   </param>
+	/// <param name="init_len">    </param>
+	/// <param name="n_jobs">    </param>
+	/// <exception cref="invalid_argument">     </exception>
+	void solve_parallel(Graph& g, LocalSearchType type, vector<int> init_sol, int init_len, int n_jobs)
+	{
+		if (type != LocalSearchType::TwoOpt && type != LocalSearchType::ThreeOpt)
+			throw invalid_argument("parallel local search is not supported: " + to_string(type));
+
 		_type = type;
 
 		_solution = init_sol;
@@ -181,9 +721,13 @@ public:
 
 		_n_cities = init_sol.size() - 1;
 
-		if (_type == "2-opt") two_opt(g);
-		else if (_type == "2.5-opt") two_half_opt(g);
-		else if (_type == "3-opt") three_opt(g);
+		_succ.resize(_n_cities);
+		update_succ(g, 0, _n_cities - 1);
+
+		if (type == LocalSearchType::TwoOpt)
+			while (!_cancel.cancelled() && parallel_two_opt_step(g, n_jobs));
+		else
+			while (!_cancel.cancelled() && parallel_three_opt_step(g, n_jobs));
 	}
 
 	/// <summary>
@@ -0,0 +1,276 @@
+#pragma once
+#include "NNSolver.h"
+
+/// <summary>
+///    -    :
+///     pi  1- ( 
+///   1..n-1      0),
+///   .   
+///   O(n^2),       
+/// </summary>
+/// <param name="g">  (  ) </param>
+/// <param name="upper">    ( ) </param>
+/// <param name="max_iter">      </param>
+/// <param name="n_jobs">    </param>
+/// <returns>      </returns>
+int held_karp_bound(Graph& g, int upper, int max_iter = 1000, int n_jobs = 1)
+{
+	int n = g.n();
+
+	if (n < 3)
+		return n < 2 ? 0 : g[0][1] + g[1][0];
+
+	//       1-
+	vector<double> pi(n), key(n);
+	vector<int> parent(n), degree(n);
+	vector<char> in_tree(n);
+
+	//      
+	bool parallel = n_jobs > 1 && n >= 1000;
+
+	double best = 0, lambda = 2;
+	int since_improvement = 0;
+
+	for (int it = 0; it < max_iter; ++it)
+	{
+		//     1..n-1   g[u][v] + pi[u] + pi[v]
+		fill(key.begin(), key.end(), (double)INF * 4);
+		fill(parent.begin(), parent.end(), -1);
+		fill(degree.begin(), degree.end(), 0);
+		fill(in_tree.begin(), in_tree.end(), 0);
+
+		key[1] = 0;
+		double w = 0;
+
+		for (int step = 1; step < n; ++step)
+		{
+			//    
+			int u = -1;
+			double u_key = (double)INF * 4;
+
+			#pragma omp parallel num_threads(n_jobs) if (parallel)
+			{
+				int local_u = -1;
+				double local_key = (double)INF * 4;
+
+				#pragma omp for nowait
+				for (int v = 1; v < n; ++v)
+					if (!in_tree[v] && key[v] < local_key)
+					{
+						local_u = v;
+						local_key = key[v];
+					}
+
+				#pragma omp critical
+				if (local_u != -1 && (local_key < u_key || (local_key == u_key && local_u < u)))
+				{
+					u = local_u;
+					u_key = local_key;
+				}
+			}
+
+			in_tree[u] = 1;
+			w += u_key;
+
+			if (parent[u] != -1)
+			{
+				++degree[u];
+				++degree[parent[u]];
+			}
+
+			int* row = g[u];
+
+			#pragma omp parallel for num_threads(n_jobs) if (parallel)
+			for (int v = 1; v < n; ++v)
+				if (!in_tree[v] && row[v] + pi[u] + pi[v] < key[v])
+				{
+					key[v] = row[v] + pi[u] + pi[v];
+					parent[v] = u;
+				}
+		}
+
+		//     0
+		int a = -1, b = -1;
+		double min1 = (double)INF * 4, min2 = (double)INF * 4;
+
+		for (int v = 1; v < n; ++v)
+		{
+			double c = g[0][v] + pi[0] + pi[v];
+
+			if (c < min1)
+			{
+				b = a; min2 = min1;
+				a = v; min1 = c;
+			}
+			else if (c < min2)
+			{
+				b = v; min2 = c;
+			}
+		}
+
+		w += min1 + min2;
+		degree[0] = 2;
+		++degree[a];
+		++degree[b];
+
+		for (int v = 0; v < n; ++v)
+			w -= 2 * pi[v];
+
+		if (w > best + 1e-9)
+		{
+			best = w;
+			since_improvement = 0;
+		}
+		else if (++since_improvement >= 20)
+		{
+			//  ,     
+			lambda /= 2;
+			since_improvement = 0;
+		}
+
+		// :     2
+		int norm = 0;
+
+		for (int v = 0; v < n; ++v)
+			norm += (degree[v] - 2) * (degree[v] - 2);
+
+		// 1- - ,  
+		if (norm == 0) break;
+
+		if (ceil(best - 1e-6) >= upper || lambda < 1e-6) break;
+
+		double t = lambda * (upper - w) / norm;
+
+		for (int v = 0; v < n; ++v)
+			pi[v] += t * (degree[v] - 2);
+	}
+
+	return (int)ceil(best - 1e-6);
+}
+
+/// <summary>
+///        :
+///        
+///     ( ). 
+///   O(n^3),      
+/// </summary>
+/// <param name="g">  </param>
+/// <param name="n_jobs">    </param>
+/// <returns>      </returns>
+int assignment_bound(Graph& g, int n_jobs = 1)
+{
+	int n = g.n();
+
+	if (n < 2) return 0;
+
+	const long long inf = (long long)INF * INF;
+
+	//   i -> j (  1,  )
+	auto cost = [&](int i, int j) { return i == j ? (long long)INF * n : (long long)g[i - 1][j - 1]; };
+
+	//    ,    
+	vector<long long> u(n + 1), v(n + 1), min_v(n + 1);
+	vector<int> p(n + 1), way(n + 1);
+	vector<char> used(n + 1);
+
+	//      
+	bool parallel = n_jobs > 1 && n >= 1000;
+
+	for (int i = 1; i <= n; ++i)
+	{
+		p[0] = i;
+		int j0 = 0;
+
+		fill(min_v.begin(), min_v.end(), inf);
+		fill(used.begin(), used.end(), 0);
+
+		do
+		{
+			used[j0] = 1;
+
+			int i0 = p[j0], j1 = 0;
+			long long delta = inf;
+
+			#pragma omp parallel num_threads(n_jobs) if (parallel)
+			{
+				int local_j = 0;
+				long long local_delta = inf;
+
+				#pragma omp for nowait
+				for (int j = 1; j <= n; ++j)
+					if (!used[j])
+					{
+						long long cur = cost(i0, j) - u[i0] - v[j];
+
+						if (cur < min_v[j])
+						{
+							min_v[j] = cur;
+							way[j] = j0;
+						}
+
+						if (min_v[j] < local_delta)
+						{
+							local_delta = min_v[j];
+							local_j = j;
+						}
+					}
+
+				#pragma omp critical
+				if (local_j != 0 && (local_delta < delta || (local_delta == delta && local_j < j1)))
+				{
+					delta = local_delta;
+					j1 = local_j;
+				}
+			}
+
+			for (int j = 0; j <= n; ++j)
+				if (used[j])
+				{
+					u[p[j]] += delta;
+					v[j] -= delta;
+				}
+				else min_v[j] -= delta;
+
+			j0 = j1;
+		} while (p[j0] != 0);
+
+		//     
+		do
+		{
+			int j1 = way[j0];
+			p[j0] = p[j1];
+			j0 = j1;
+		} while (j0 != 0);
+	}
+
+	return (int)-v[0];
+}
+
+/// <summary>
+///     :   - 
+///   ,     
+/// </summary>
+/// <param name="g">  </param>
+/// <param name="n_jobs">    </param>
+/// <returns>      </returns>
+int tour_lower_bound(Graph& g, int n_jobs = 1)
+{
+	if (!g.is_symmetric()) return assignment_bound(g, n_jobs);
+
+	//      
+	NNSolver nn;
+	nn.solve(g);
+
+	return held_karp_bound(g, nn.len(), 1000, n_jobs);
+}
+
+/// <summary>
+///       
+/// </summary>
+/// <param name="len">   </param>
+/// <param name="bound">   </param>
+/// <returns> (len - bound) / bound </returns>
+double gap(int len, int bound)
+{
+	return bound > 0 ? (double)(len - bound) / bound : 0;
+}
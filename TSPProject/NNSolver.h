@@ -3,12 +3,32 @@
 
 /// <summary>
 ///    
-/// :   
+/// :   .
+///    (rcl > 1)   
+///   rcl   (  GRASP)
 /// </summary>
 class NNSolver : public TSPSolver
 {
+	/// <summary>
+	///    (1 -    )
+	/// </summary>
+	int _rcl;
+
+	/// <summary>
+	///      : ( , )
+	///   .    solve
+	/// </summary>
+	vector<int> _visited;
+	vector<pair<int, int>> _candidates;
+
 public:
 
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="rcl">    </param>
+	NNSolver(int rcl = 1) : _rcl(max(rcl, 1)) {}
+
 	/// <summary>
 	///  
 	/// </summary>
@@ -18,7 +38,8 @@ public:
 
 		// visited[i] = 0 <=>  i  
 		// visited[i] = 1 <=>  i 
-		vector <int> visited(_n_cities);
+		_visited.assign(_n_cities, 0);
+		_candidates.resize(_rcl);
 
 		//    
 		uniform_int_distribution <int> interval_int(0, _n_cities - 1);
@@ -28,7 +49,7 @@ public:
 
 		// : cur -> ... 
 		_solution[0] = cur; _len = 0;
-		visited[cur] = 1;
+		_visited[cur] = 1;
 
 		//    
 		for (int i = 1; i < _n_cities; ++i)
@@ -36,18 +57,44 @@ public:
 			//   next
 			int next = cur, dist = INF;
 
-			//       j 
-			//       cur
-			for (int j = 0; j < _n_cities; ++j)
-				if (!visited[j] && g[cur][j] < dist)
+			if (_rcl == 1)
+			{
+				//       j 
+				//       cur
+				for (int j = 0; j < _n_cities; ++j)
+					if (!_visited[j] && g[cur][j] < dist)
+					{
+						next = j;
+						dist = g[cur][j];
+					}
+			}
+			else
+			{
+				// rcl     ()
+				int size = 0;
+
+				for (int j = 0; j < _n_cities; ++j)
 				{
-					next = j;
-					dist = g[cur][j];
+					if (_visited[j] || (size == _rcl && g[cur][j] >= _candidates[size - 1].first)) continue;
+
+					int p = size < _rcl ? size++ : size - 1;
+
+					for (; p > 0 && _candidates[p - 1].first > g[cur][j]; --p)
+						_candidates[p] = _candidates[p - 1];
+
+					_candidates[p] = { g[cur][j], j };
 				}
 
+				uniform_int_distribution <int> pick(0, size - 1);
+				int c = pick(gen);
+
+				next = _candidates[c].second;
+				dist = _candidates[c].first;
+			}
+
 			// : ... -> cur -> next -> ...
 			_solution[i] = next; _len += dist;
-			visited[next] = 1;
+			_visited[next] = 1;
 
 			cur = next;
 		}
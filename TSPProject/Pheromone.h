@@ -0,0 +1,131 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <omp.h>
+
+#include "Arena.h"
+
+/// <summary>
+///    :
+/// weights[i][j] = tau[i][j]^alpha * eta_beta[i][j]
+/// </summary>
+/// <param name="weights">    </param>
+/// <param name="tau">    </param>
+/// <param name="eta_beta">    (  -beta) </param>
+/// <param name="alpha">   </param>
+/// <param name="n_jobs">    </param>
+void update_weights(Matrix<double>& weights, Matrix<double>& tau, Matrix<double>& eta_beta, double alpha, int n_jobs)
+{
+	int n = tau.rows();
+
+	#pragma omp parallel for num_threads(n_jobs)
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < n; ++j)
+			weights[i][j] = pow(tau[i][j], alpha) * eta_beta[i][j];
+}
+
+/// <summary>
+///     
+/// </summary>
+/// <param name="tau">    </param>
+/// <param name="rho">    </param>
+/// <param name="n_jobs">    </param>
+void evaporate(Matrix<double>& tau, double rho, int n_jobs)
+{
+	int n = tau.rows();
+
+	#pragma omp parallel for num_threads(n_jobs)
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < n; ++j)
+			tau[i][j] *= (1 - rho);
+}
+
+/// <summary>
+///      
+/// </summary>
+/// <param name="tau">    </param>
+/// <param name="solution">  (  ) </param>
+/// <param name="w">    </param>
+/// <param name="n_jobs">    </param>
+void deposit_tour(Matrix<double>& tau, const vector<int>& solution, double w, int n_jobs)
+{
+	int n = (int)solution.size() - 1;
+
+	#pragma omp parallel for num_threads(n_jobs)
+	for (int j = 0; j < n; ++j)
+		tau[solution[j]][solution[j + 1]] += w;
+}
+
+/// <summary>
+///     ,     tau_min (MMAS)
+/// </summary>
+/// <param name="tau">    </param>
+/// <param name="rho">    </param>
+/// <param name="tau_min">    </param>
+/// <param name="n_jobs">    </param>
+void evaporate_clamped(Matrix<double>& tau, double rho, double tau_min, int n_jobs)
+{
+	int n = tau.rows();
+
+	#pragma omp parallel for num_threads(n_jobs)
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < n; ++j)
+			tau[i][j] = max(tau_min, tau[i][j] * (1 - rho));
+}
+
+/// <summary>
+///  MMAS   lambda- :  
+///        min + lambda * (max - min)
+/// (min  max -      )
+/// </summary>
+/// <param name="tau">    </param>
+/// <param name="rho">    </param>
+/// <param name="tau_min">    </param>
+/// <param name="lambda">     </param>
+/// <param name="n_jobs">    </param>
+/// <returns>       </returns>
+int evaporate_branching(Matrix<double>& tau, double rho, double tau_min, double lambda, int n_jobs)
+{
+	int n = tau.rows(), branching = 0;
+
+	#pragma omp parallel for num_threads(n_jobs) reduction(+ : branching)
+	for (int i = 0; i < n; ++i)
+	{
+		double row_min = HUGE_VAL, row_max = 0;
+
+		for (int j = 0; j < n; ++j)
+		{
+			tau[i][j] = max(tau_min, tau[i][j] * (1 - rho));
+
+			if (j == i) continue;
+
+			row_min = min(row_min, tau[i][j]);
+			row_max = max(row_max, tau[i][j]);
+		}
+
+		double threshold = row_min + lambda * (row_max - row_min);
+
+		for (int j = 0; j < n; ++j)
+			branching += (j != i && tau[i][j] >= threshold);
+	}
+
+	return branching;
+}
+
+/// <summary>
+///      ,   tau_max (MMAS)
+/// </summary>
+/// <param name="tau">    </param>
+/// <param name="solution">  (  ) </param>
+/// <param name="w">    </param>
+/// <param name="tau_max">    </param>
+/// <param name="n_jobs">    </param>
+void deposit_tour_clamped(Matrix<double>& tau, const vector<int>& solution, double w, double tau_max, int n_jobs)
+{
+	int n = (int)solution.size() - 1;
+
+	#pragma omp parallel for num_threads(n_jobs)
+	for (int j = 0; j < n; ++j)
+		tau[solution[j]][solution[j + 1]] = min(tau_max, tau[solution[j]][solution[j + 1]] + w);
+}
@@ -0,0 +1,269 @@
+#pragma once
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <stdexcept>
+
+#include "KOptSolver.h"
+
+/// <summary>
+///      (  
+///    ,  ,   ):
+/// <para> - None (   ) </para>
+/// <para> - Hilbert (   ,  ) </para>
+/// <para> - RCM (   -     ) </para>
+/// <para> - Auto (Hilbert,   ,  RCM) </para>
+/// </summary>
+enum class ReorderType { None, Hilbert, RCM, Auto };
+
+/// <summary>
+///     
+/// </summary>
+/// <param name="name"> : none, hilbert, rcm, auto </param>
+/// <returns>   </returns>
+ReorderType to_reorder_type(const string& name)
+{
+	if (name == "none") return ReorderType::None;
+	if (name == "hilbert") return ReorderType::Hilbert;
+	if (name == "rcm") return ReorderType::RCM;
+	if (name == "auto") return ReorderType::Auto;
+
+	throw invalid_argument("unknown reorder type: " + name);
+}
+
+/// <summary>
+///   
+/// </summary>
+/// <param name="type">   </param>
+/// <returns> : none, hilbert, rcm, auto </returns>
+string to_string(ReorderType type)
+{
+	switch (type)
+	{
+	case ReorderType::Hilbert: return "hilbert";
+	case ReorderType::RCM: return "rcm";
+	case ReorderType::Auto: return "auto";
+	default: return "none";
+	}
+}
+
+/// <summary>
+///    side x side   
+/// </summary>
+/// <param name="side">   ( ) </param>
+/// <param name="x">   </param>
+/// <param name="y">   </param>
+/// <returns>     </returns>
+long long hilbert_index(int side, int x, int y)
+{
+	long long d = 0;
+
+	for (int s = side / 2; s > 0; s /= 2)
+	{
+		int rx = (x & s) > 0, ry = (y & s) > 0;
+		d += (long long)s * s * ((3 * rx) ^ ry);
+
+		//  ,        
+		if (ry == 0)
+		{
+			if (rx == 1)
+			{
+				x = s - 1 - x;
+				y = s - 1 - y;
+			}
+
+			swap(x, y);
+		}
+	}
+
+	return d;
+}
+
+/// <summary>
+///      (
+///    2^16 x 2^16)
+/// </summary>
+/// <param name="g">    </param>
+/// <returns> order[i] -   ,   i </returns>
+vector<int> hilbert_order(Graph& g)
+{
+	assert(g.has_coords());
+
+	int n = g.n();
+	const int side = 1 << 16;
+
+	vector<double>& x = g.x();
+	vector<double>& y = g.y();
+
+	double min_x = *min_element(x.begin(), x.end()), max_x = *max_element(x.begin(), x.end());
+	double min_y = *min_element(y.begin(), y.end()), max_y = *max_element(y.begin(), y.end());
+	double scale = (side - 1) / max(1e-9, max(max_x - min_x, max_y - min_y));
+
+	vector<long long> key(n);
+
+	for (int i = 0; i < n; ++i)
+		key[i] = hilbert_index(side, (int)((x[i] - min_x) * scale), (int)((y[i] - min_y) * scale));
+
+	vector<int> order(n);
+	iota(order.begin(), order.end(), 0);
+
+	stable_sort(order.begin(), order.end(), [&](int a, int b) { return key[a] < key[b]; });
+
+	return order;
+}
+
+/// <summary>
+///    -    
+/// k  :       ,
+///  -   ,   
+/// </summary>
+/// <param name="g">  </param>
+/// <param name="k">    </param>
+/// <param name="n_jobs">    </param>
+/// <returns> order[i] -   ,   i </returns>
+vector<int> rcm_order(Graph& g, int k = 8, int n_jobs = 1)
+{
+	int n = g.n();
+
+	if (n < 2) return vector<int>(n, 0);
+
+	Neighbors nn(g, k, n_jobs);
+
+	vector<vector<int>> adj(n);
+
+	for (int i = 0; i < n; ++i)
+		for (int j : nn.out[i])
+		{
+			adj[i].push_back(j);
+			adj[j].push_back(i);
+		}
+
+	for (int i = 0; i < n; ++i)
+	{
+		sort(adj[i].begin(), adj[i].end());
+		adj[i].erase(unique(adj[i].begin(), adj[i].end()), adj[i].end());
+	}
+
+	auto by_degree = [&](int a, int b) { return adj[a].size() < adj[b].size() || (adj[a].size() == adj[b].size() && a < b); };
+
+	for (int i = 0; i < n; ++i)
+		sort(adj[i].begin(), adj[i].end(), by_degree);
+
+	//     ,  -    
+	vector<int> starts(n);
+	iota(starts.begin(), starts.end(), 0);
+	sort(starts.begin(), starts.end(), by_degree);
+
+	vector<int> order;
+	order.reserve(n);
+
+	vector<char> visited(n, 0);
+
+	for (int s : starts)
+	{
+		if (visited[s]) continue;
+
+		queue<int> q;
+		q.push(s);
+		visited[s] = 1;
+
+		while (!q.empty())
+		{
+			int v = q.front();
+			q.pop();
+
+			order.push_back(v);
+
+			for (int u : adj[v])
+				if (!visited[u])
+				{
+					visited[u] = 1;
+					q.push(u);
+				}
+		}
+	}
+
+	reverse(order.begin(), order.end());
+
+	return order;
+}
+
+/// <summary>
+///    
+/// </summary>
+/// <param name="g">  </param>
+/// <param name="type">   </param>
+/// <param name="n_jobs">    </param>
+/// <returns> order[i] -   ,   i </returns>
+vector<int> locality_order(Graph& g, ReorderType type, int n_jobs = 1)
+{
+	if (type == ReorderType::Auto) type = g.has_coords() ? ReorderType::Hilbert : ReorderType::RCM;
+
+	if (type == ReorderType::Hilbert) return hilbert_order(g);
+	if (type == ReorderType::RCM) return rcm_order(g, 8, n_jobs);
+
+	vector<int> order(g.n());
+	iota(order.begin(), order.end(), 0);
+
+	return order;
+}
+
+/// <summary>
+///    :  i   -
+///  order[i]  (    )
+/// </summary>
+/// <param name="g">   </param>
+/// <param name="order">   (. locality_order) </param>
+/// <param name="n_jobs">    </param>
+/// <returns>   </returns>
+Graph permute(Graph& g, const vector<int>& order, int n_jobs = 1)
+{
+	int n = g.n();
+
+	if (g.has_coords())
+	{
+		vector<double> x(n), y(n);
+
+		for (int i = 0; i < n; ++i)
+		{
+			x[i] = g.x()[order[i]];
+			y[i] = g.y()[order[i]];
+		}
+
+		Graph result(x, y, n_jobs);
+
+		//        
+		#pragma omp parallel for num_threads(n_jobs)
+		for (int i = 0; i < n; ++i)
+			for (int j = 0; j < n; ++j)
+				result[i][j] = g[order[i]][order[j]];
+
+		return result;
+	}
+
+	vector<int> data((size_t)n * n);
+
+	#pragma omp parallel for num_threads(n_jobs)
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < n; ++j)
+			data[(size_t)i * n + j] = g[order[i]][order[j]];
+
+	return Graph(move(data), n);
+}
+
+/// <summary>
+///        
+/// </summary>
+/// <param name="tour">    </param>
+/// <param name="order">   (. locality_order) </param>
+/// <returns>     </returns>
+vector<int> restore_tour(const vector<int>& tour, const vector<int>& order)
+{
+	vector<int> result(tour.size());
+
+	for (size_t j = 0; j < tour.size(); ++j)
+		result[j] = order[tour[j]];
+
+	return result;
+}
@@ -1,5 +1,8 @@
 #include "NNSolver.h"
 #include "ACOSolver.h"
+#include "LowerBound.h"
+#include "Tuner.h"
+#include "BackboneSolver.h"
 
 #include <chrono>
 #include <iomanip>
@@ -7,7 +10,7 @@ using namespace chrono;
 
 /// <summary>
 /// Поиск оптимальных значений параметров 
-/// муравьиного алгоритма
+/// муравьиного алгоритма (гонка кандидатов, см. Tuner.h)
 /// </summary>
 /// <param name="g"> граф </param>
 /// <param name="alg"> муравьиный алгоритм </param>
@@ -16,101 +19,57 @@ void search_opt_params(Graph& g, string alg)
 	NNSolver alg1;
 	alg1.solve(g);
 
-	map<string, any> params = {
-		{"alpha", 1.0},
-		{"beta", 5.0},
-		{"rho", 0.9},
-		{"n_ants", 24},
-		{"a", 0.5 / g.n()},
-		{"tau0",  5.0 / alg1.len()},
-		{"max_iter", 1500},
-		{"local_search_type", (string)"2-opt"},
-		{"local_search_tours", (string)"k-random"},
-		{"k", 24},
-		{"n_jobs", 2}
-	};
+	ACOConfig base;
+	base.type = to_aco_type(alg);
+	base.alpha = 1.0;
+	base.n_ants = 24;
+	base.a = 0.5 / g.n();
+	base.tau0 = 5.0 / alg1.len();
+	base.max_iter = 1500;
+	base.local_search_type = LocalSearchType::TwoOpt;
+	base.local_search_tours = LocalSearchTours::KRandom;
+	base.k = 24;
+
+	vector<ACOConfig> candidates;
+
+	for (double beta = 1.1; beta < 4.1; beta += 0.4)
+		for (double rho = 0.3; rho < 1; rho += 0.2)
+		{
+			ACOConfig config = base;
+			config.beta = beta;
+			config.rho = rho;
+
+			candidates.push_back(config);
+		}
 
 	cout << "+------------------------------+\n";
 	cout << "|         Find Params          |\n";
 	cout << "+------------------------------+\n\n";
 
-	double best_beta = 0, best_rho = 0, best_time = 0, best_avg_len = 0;
-	int best_iter = 0, best_len = INF;
+	// не больше запусков, чем у полного перебора по 10 запусков
+	Tuner tuner(candidates, thread::hardware_concurrency(), 10 * candidates.size());
 
-	for (double beta = 1.1; beta < 4.1; beta += 0.4)
-		for (double rho = 0.3; rho < 1; rho += 0.2)
-			for (int max_iter = 1500; max_iter <= 1500; max_iter += 500)
-			{
-				cout << "beta = " << beta << ", rho = " << rho << ", max_iter = " << max_iter << " : \n\n";
-
-				params["beta"] = beta;
-				params["rho"] = rho;
-				params["max_iter"] = max_iter;
-
-				cout << "+-----+------------+-----------+\n";
-				cout << "| No. |  Решение   |   Время   |\n";
-				cout << "+-----+------------+-----------+\n";
-
-				double len_sum = 0, time_sum = 0;
-				int iters = 10, cur_best_len = INF;
-
-				for (int i = 0; i < iters; ++i)
-				{
-					ACOSolver alg2(alg, params);
-
-					system_clock::time_point start = system_clock::now();
-
-					alg2.solve(g);
-
-					system_clock::time_point end = system_clock::now();
-					duration <double> delta = end - start;
-
-					//cout << left << "| " << setw(2) << i + 1 << "  |  " << setw(8) << alg2.len() << "  |   " << setw(6) << delta.count() << "  |\n";
-
-					len_sum += alg2.len();
-					time_sum += delta.count();
-					cur_best_len = min(best_len, alg2.len());
-				}
-
-				//cout << "+-----+------------+-----------+\n";
-				cout << left << "| BST |  " << setw(8) << cur_best_len << "  |   " << setw(6) << "----" << "  |\n";
-				cout << left << "| AVG |  " << setw(8) << len_sum / iters << "  |   " << setw(6) << time_sum / iters << "  |\n";
-				cout << "+-----+------------+-----------+\n\n";
-
-				if (cur_best_len < best_len)
-				{
-					best_beta = beta;
-					best_rho = rho;
-					best_iter = max_iter;
-
-					best_len = cur_best_len;
-					best_avg_len = len_sum / iters;
-					best_time = time_sum / iters;
-				}
-				else if (len_sum < best_avg_len * iters)
-				{
-					best_beta = beta;
-					best_rho = rho;
-					best_iter = max_iter;
-
-					best_len = cur_best_len;
-					best_avg_len = len_sum / iters;
-					best_time = time_sum / iters;
-				}
-				else if (time_sum < best_time * iters)
-				{
-					best_beta = beta;
-					best_rho = rho;
-					best_iter = max_iter;
-
-					best_len = cur_best_len;
-					best_avg_len = len_sum / iters;
-					best_time = time_sum / iters;
-				}
-			} 
-
-	cout << "BEST PARAMS: beta = " << best_beta << ", rho = " << best_rho << ", max_iter = " << best_iter << ", len = " << best_len << "\n";
-	cout << "RESULTS: best_len = " << best_len << ", avg_len = " << best_avg_len << ", time = " << best_time << "\n";
+	system_clock::time_point start = system_clock::now();
+
+	vector<Graph*> instances = { &g };
+	ACOConfig best = tuner.tune(instances);
+
+	system_clock::time_point end = system_clock::now();
+	duration <double> delta = end - start;
+
+	cout << "+------+------+--------+------------+\n";
+	cout << "| beta | rho  | Блоков |  Ср. длина |\n";
+	cout << "+------+------+--------+------------+\n";
+
+	for (int c = 0; c < (int)candidates.size(); ++c)
+		cout << left << "| " << setw(4) << candidates[c].beta << " | " << setw(4) << candidates[c].rho << " |  "
+			<< setw(5) << tuner.blocks(c) << " |  " << setw(8) << tuner.mean_len(c) << "  |\n";
+
+	cout << "+------+------+--------+------------+\n\n";
+
+	cout << "BEST PARAMS: beta = " << best.beta << ", rho = " << best.rho << ", max_iter = " << best.max_iter << "\n";
+	cout << "RESULTS: experiments = " << tuner.experiments() << ", survivors = " << tuner.survivors()
+		<< ", time = " << delta.count() << "\n";
 }
 
 /// <summary>
@@ -122,36 +81,40 @@ void check_as(Graph &g)
 	NNSolver alg1;
 	alg1.solve(g);
 
-	double p = pow(0.05, 1.0 / g.n());
-
-	map<string, any> params = {
-		{"alpha", 1.0},
-		{"beta", 3.5},
-		{"rho", 0.2},
-		{"n_ants", 24},
-		{"a", 0.5 / g.n()},
-		{"tau0",  5.0 / alg1.len()},
-		{"max_iter", 200},
-		{"local_search_type", (string)"3-opt"},
-		{"local_search_tours", (string)"k-random"},
-		{"k", 12},
-		{"n_jobs", 4}
-	};
+	ACOConfig config;
+	config.type = ACOType::MMAS;
+	config.alpha = 1.0;
+	config.beta = 3.5;
+	config.rho = 0.2;
+	config.n_ants = 24;
+	config.a = 0.5 / g.n();
+	config.tau0 = 5.0 / alg1.len();
+	config.max_iter = 200;
+	config.local_search_type = LocalSearchType::ThreeOpt;
+	config.local_search_tours = LocalSearchTours::KRandom;
+	config.k = 12;
+	config.n_jobs = 4;
+
+	// останавливаемся, если достигнута нижняя оценка
+	config.lower_bound = tour_lower_bound(g, config.n_jobs);
+	config.target_gap = 0;
 
 	cout << "+------------------------------+\n";
 	cout << "|          Ant System          |\n";
 	cout << "+------------------------------+\n\n";
 
-	cout << "+-----+------------+-----------+\n";
-	cout << "| No. |  Решение   |   Время   |\n";
-	cout << "+-----+------------+-----------+\n";
+	cout << "Нижняя оценка: " << config.lower_bound << "\n\n";
+
+	cout << "+-----+------------+-----------+----------+\n";
+	cout << "| No. |  Решение   |   Время   |  Отклон. |\n";
+	cout << "+-----+------------+-----------+----------+\n";
 
 	double len_sum = 0, time_sum = 0;
 	int iters = 25, best_len = INF;
 
 	for (int i = 0; i < iters; ++i)
 	{
-		ACOSolver alg2("MMAS", params);
+		ACOSolver alg2(config);
 
 		system_clock::time_point start = system_clock::now();
 
@@ -160,17 +123,62 @@ void check_as(Graph &g)
 		system_clock::time_point end = system_clock::now();
 		duration <double> delta = end - start;
 
-		cout << left << "| " << setw(3) << i + 1 << " |  " << setw(8) << alg2.len() << "  |   " << setw(6) << delta.count() << "  |\n";
+		cout << left << "| " << setw(3) << i + 1 << " |  " << setw(8) << alg2.len() << "  |   " << setw(6) << delta.count()
+			<< "  |  " << setw(6) << 100 * gap(alg2.len(), config.lower_bound) << "% |\n";
 
 		len_sum += alg2.len();
 		time_sum += delta.count();
 		best_len = min(best_len, alg2.len());
 	}
 
-	cout << "+-----+------------+-----------+\n";
-	cout << left << "| BST |  " << setw(8) << best_len << "  |   " << setw(6) << "----" << "  |\n";
-	cout << left << "| AVG |  " << setw(8) << len_sum / iters << "  |   " << setw(6) << time_sum / iters << "  |\n";
-	cout << "+-----+------------+-----------+\n\n"; 
+	cout << "+-----+------------+-----------+----------+\n";
+	cout << left << "| BST |  " << setw(8) << best_len << "  |   " << setw(6) << "----"
+		<< "  |  " << setw(6) << 100 * gap(best_len, config.lower_bound) << "% |\n";
+	cout << left << "| AVG |  " << setw(8) << len_sum / iters << "  |   " << setw(6) << time_sum / iters
+		<< "  |  " << setw(6) << 100 * (len_sum / iters - config.lower_bound) / config.lower_bound << "% |\n";
+	cout << "+-----+------------+-----------+----------+\n\n"; 
+}
+
+/// <summary>
+/// Запускаем MMAS с фиксацией хребта при сильном сжатии графа
+/// (a = 0.1, за этап фиксируется до 90% дуг): на поздних этапах
+/// a пересчитывается для графа в десятки раз меньше исходного
+/// </summary>
+/// <param name="g"> граф </param>
+void check_backbone(Graph& g)
+{
+	NNSolver alg1;
+	alg1.solve(g);
+
+	ACOConfig config;
+	config.type = ACOType::MMAS;
+	config.beta = 3.0;
+	config.n_ants = 24;
+	config.a = 0.1;
+	config.tau0 = 5.0 / alg1.len();
+	config.max_iter = 100;
+
+	BackboneSolver alg2(config, 8, 1.0, 0.9);
+	alg2.solve(g);
+
+	vector<int> sol = alg2.solution();
+	vector<char> seen(g.n(), 0);
+	int sum = 0;
+
+	for (int i = 0; i < g.n(); ++i)
+	{
+		assert(!seen[sol[i]]);
+		seen[sol[i]] = 1;
+		sum += g[sol[i]][sol[i + 1]];
+	}
+
+	cout << "Этапы:";
+
+	for (int m : alg2.stage_sizes())
+		cout << " " << m;
+
+	cout << "\nsum = " << sum << ", ans = " << alg2.len() << "\n";
+	assert(sum == alg2.len() && sol[0] == sol[g.n()]);
 }
 
 int main()
@@ -181,6 +189,7 @@ int main()
 	Graph g("ftv170.atsp");
 	
 	//search_opt_params(g, "MMAS");
+	//check_backbone(g);
 	check_as(g);
 
 	/*
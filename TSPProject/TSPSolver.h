@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <random>
 #include <ctime>
+#include <thread>
 #include <omp.h>
 
 #include "Graph.h"
@@ -14,9 +15,10 @@
 const int INF = 1e9 + 7;
 
 /// <summary>
-///   
+///    (   :
+///    )
 /// </summary>
-mt19937 gen(time(NULL));
+thread_local mt19937 gen(time(NULL) + hash<thread::id>()(this_thread::get_id()));
 
 /// <summary>
 ///   - ,
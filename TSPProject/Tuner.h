@@ -0,0 +1,286 @@
+#pragma once
+#include <functional>
+
+#include "NNSolver.h"
+#include "ACOSolver.h"
+
+/// <summary>
+///      (F-race):
+///         (
+///  ),       
+/// ,   ,    .
+///   (   ,  
+/// ,  )  ,    
+/// </summary>
+class Tuner
+{
+	/// <summary>
+	///    "  "
+	/// </summary>
+	vector<ACOConfig> _candidates;
+	vector<char> _alive;
+
+	/// <summary>
+	/// : _results[c][b] -    c   b
+	/// </summary>
+	vector<vector<int>> _results;
+
+	/// <summary>
+	///  :
+	/// <para> - n_jobs (  ) </para>
+	/// <para> - max_experiments (   ) </para>
+	/// <para> - first_test (    ) </para>
+	/// </summary>
+	int _n_jobs, _max_experiments, _first_test;
+
+	/// <summary>
+	///      
+	/// </summary>
+	int _experiments, _blocks;
+
+	/// <summary>
+	///      (, tau0)
+	/// </summary>
+	function<void(ACOConfig&, Graph&)> _adapt;
+
+	/// <summary>
+	///   0.95  -
+	/// (  - )
+	/// </summary>
+	/// <param name="df">    </param>
+	static double chi2_quantile(int df)
+	{
+		const double z = 1.6448536;
+		double h = 2.0 / (9 * df);
+
+		return df * pow(1 - h + z * sqrt(h), 3);
+	}
+
+	/// <summary>
+	///   0.975  
+	/// (  - )
+	/// </summary>
+	/// <param name="df">    </param>
+	static double t_quantile(int df)
+	{
+		const double z = 1.959964;
+
+		return z + (pow(z, 3) + z) / (4.0 * df) + (5 * pow(z, 5) + 16 * pow(z, 3) + 3 * z) / (96.0 * df * df);
+	}
+
+	/// <summary>
+	///      b (  - )
+	/// </summary>
+	/// <param name="alive">   </param>
+	/// <param name="b">   </param>
+	vector<double> ranks(vector<int>& alive, int b)
+	{
+		int k = alive.size();
+
+		vector<int> order(k);
+
+		for (int j = 0; j < k; ++j)
+			order[j] = j;
+
+		sort(order.begin(), order.end(), [&](int x, int y) { return _results[alive[x]][b] < _results[alive[y]][b]; });
+
+		vector<double> rank(k);
+
+		for (int l = 0, r; l < k; l = r)
+		{
+			for (r = l; r < k && _results[alive[order[r]]][b] == _results[alive[order[l]]][b]; ++r);
+
+			for (int x = l; x < r; ++x)
+				rank[order[x]] = (l + r + 1) / 2.0;
+		}
+
+		return rank;
+	}
+
+	/// <summary>
+	///       
+	/// </summary>
+	/// <param name="alive">   </param>
+	/// <param name="square_sum">     </param>
+	vector<double> rank_sums(vector<int>& alive, double& square_sum)
+	{
+		vector<double> sums(alive.size());
+		square_sum = 0;
+
+		for (int b = 0; b < _blocks; ++b)
+		{
+			vector<double> rank = ranks(alive, b);
+
+			for (int j = 0; j < (int)alive.size(); ++j)
+			{
+				sums[j] += rank[j];
+				square_sum += rank[j] * rank[j];
+			}
+		}
+
+		return sums;
+	}
+
+	/// <summary>
+	///       :
+	///  ,     
+	/// </summary>
+	void race_step()
+	{
+		vector<int> alive;
+
+		for (int c = 0; c < (int)_candidates.size(); ++c)
+			if (_alive[c]) alive.push_back(c);
+
+		int k = alive.size(), b = _blocks;
+
+		if (k < 2) return;
+
+		double square_sum;
+		vector<double> sums = rank_sums(alive, square_sum);
+
+		double denom = square_sum - b * k * (k + 1.0) * (k + 1.0) / 4;
+
+		//   
+		if (denom <= 0) return;
+
+		double spread = 0;
+
+		for (double sum : sums)
+			spread += (sum - b * (k + 1.0) / 2) * (sum - b * (k + 1.0) / 2);
+
+		double t = (k - 1) * spread / denom;
+
+		if (t <= chi2_quantile(k - 1)) return;
+
+		int best = min_element(sums.begin(), sums.end()) - sums.begin();
+
+		double crit = t_quantile((b - 1) * (k - 1))
+			* sqrt(2 * b * max(0.0, 1 - t / (b * (k - 1.0))) * denom / ((b - 1.0) * (k - 1)));
+
+		for (int j = 0; j < k; ++j)
+			if (sums[j] - sums[best] > crit) _alive[alive[j]] = 0;
+	}
+
+public:
+
+	/// <summary>
+	/// 
+	/// </summary>
+	/// <param name="candidates">  (n_jobs      1) </param>
+	/// <param name="n_jobs">    </param>
+	/// <param name="max_experiments">     </param>
+	/// <param name="first_test">      </param>
+	/// <param name="adapt">      </param>
+	Tuner(vector<ACOConfig> candidates, int n_jobs, int max_experiments, int first_test = 5,
+		function<void(ACOConfig&, Graph&)> adapt = nullptr)
+		: _candidates(candidates), _n_jobs(n_jobs), _max_experiments(max_experiments),
+		_first_test(max(first_test, 2)), _experiments(0), _blocks(0), _adapt(adapt)
+	{
+		assert(!_candidates.empty());
+	}
+
+	/// <summary>
+	///  .       
+	/// ( ,    ,    )
+	/// </summary>
+	/// <param name="instances">   </param>
+	/// <returns>    (    ) </returns>
+	ACOConfig tune(vector<Graph*> instances)
+	{
+		assert(!instances.empty());
+
+		int n = _candidates.size();
+
+		_alive.assign(n, 1);
+		_results.assign(n, {});
+		_experiments = _blocks = 0;
+
+		while (survivors() > 1 && _experiments + survivors() <= _max_experiments)
+		{
+			vector<int> alive;
+
+			for (int c = 0; c < n; ++c)
+				if (_alive[c]) alive.push_back(c);
+
+			int k = alive.size();
+
+			//   ,  ,    
+			int batch = max(1, min(_n_jobs / k, (_max_experiments - _experiments) / k));
+
+			for (int c : alive)
+				_results[c].resize(_blocks + batch);
+
+			#pragma omp parallel for num_threads(_n_jobs) schedule(dynamic)
+			for (int t = 0; t < batch * k; ++t)
+			{
+				int c = alive[t % k], b = _blocks + t / k;
+				Graph& g = *instances[b % instances.size()];
+
+				ACOConfig config = _candidates[c];
+				config.n_jobs = 1;
+
+				if (_adapt) _adapt(config, g);
+
+				ACOSolver solver(config);
+				solver.solve(g);
+
+				_results[c][b] = solver.len();
+			}
+
+			_blocks += batch;
+			_experiments += batch * k;
+
+			if (_blocks >= _first_test) race_step();
+		}
+
+		return _candidates[best()];
+	}
+
+	/// <summary>
+	///      (  )
+	/// </summary>
+	int best()
+	{
+		vector<int> alive;
+
+		for (int c = 0; c < (int)_candidates.size(); ++c)
+			if (_alive[c]) alive.push_back(c);
+
+		if (_blocks == 0) return alive[0];
+
+		double square_sum;
+		vector<double> sums = rank_sums(alive, square_sum);
+
+		return alive[min_element(sums.begin(), sums.end()) - sums.begin()];
+	}
+
+	/// <summary>
+	///        
+	/// </summary>
+	/// <param name="c">   </param>
+	double mean_len(int c)
+	{
+		double sum = 0;
+
+		for (int len : _results[c])
+			sum += len;
+
+		return _results[c].empty() ? 0 : sum / _results[c].size();
+	}
+
+	/// <summary>
+	///  ,   c
+	/// </summary>
+	int blocks(int c) { return _results[c].size(); }
+
+	/// <summary>
+	///     
+	/// </summary>
+	int survivors() { return count(_alive.begin(), _alive.end(), 1); }
+
+	/// <summary>
+	///    
+	/// </summary>
+	int experiments() { return _experiments; }
+};